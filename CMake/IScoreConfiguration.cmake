@@ -34,6 +34,8 @@ option(SCORE_BUILD_FOR_PACKAGE_MANAGER "Set FHS-friendly install paths" OFF)
 option(SCORE_IEEE "Use a graphical skin adapted to publication" OFF)
 option(SCORE_WEBSOCKETS "Run a websocket server in the scenario" OFF)
 option(SCORE_TESTBED "Enable the testbed. See Tests/testbed/README" OFF)
+option(SCORE_BENCHMARKS "Build the benchmarks in base/benchmarks" OFF)
+option(SCORE_TOOLS "Build the command-line tools in base/tools" ON)
 option(SCORE_PLAYER "Build standalone player" OFF)
 option(DEFINE_SCORE_SCENARIO_DEBUG_RECTS "Enable to have debug rects around elements of a scenario" OFF)
 
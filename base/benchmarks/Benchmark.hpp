@@ -0,0 +1,96 @@
+#pragma once
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+#include <QTextStream>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+
+/**
+ * Tools shared by the benchmarks: timings of repeated measures,
+ * and output of the results as JSON.
+ */
+namespace benchmark
+{
+struct Timing
+{
+  qint64 count{};
+  qint64 total{};
+  qint64 min{std::numeric_limits<qint64>::max()};
+  qint64 max{};
+
+  void add(qint64 ns)
+  {
+    count++;
+    total += ns;
+    min = std::min(min, ns);
+    max = std::max(max, ns);
+  }
+
+  QJsonObject toJson() const
+  {
+    QJsonObject obj;
+    obj["count"] = count;
+    obj["total_ns"] = total;
+    obj["min_ns"] = count > 0 ? min : 0;
+    obj["max_ns"] = max;
+    obj["mean_ns"] = count > 0 ? double(total) / count : 0.;
+    return obj;
+  }
+};
+
+//! Timings of a phase, by entry (command, jump, operation...)
+using PhaseTimings = std::map<QString, Timing>;
+
+inline QJsonObject toJson(const PhaseTimings& phase)
+{
+  Timing all;
+  QJsonObject entries;
+  for (const auto& [name, timing] : phase)
+  {
+    entries[name] = timing.toJson();
+    all.count += timing.count;
+    all.total += timing.total;
+    all.min = std::min(all.min, timing.min);
+    all.max = std::max(all.max, timing.max);
+  }
+
+  QJsonObject obj;
+  obj["all"] = all.toJson();
+  obj["entries"] = entries;
+  return obj;
+}
+
+template <typename F>
+qint64 measure(F&& f)
+{
+  QElapsedTimer t;
+  t.start();
+  f();
+  return t.nsecsElapsed();
+}
+
+//! Writes the results to a file, or to stdout if the path is empty.
+//! Returns the exit code of the benchmark.
+inline int writeResults(const QJsonObject& results, const QString& path)
+{
+  const auto json = QJsonDocument{results}.toJson();
+  if (path.isEmpty())
+  {
+    QTextStream{stdout} << json;
+    return 0;
+  }
+
+  QFile f{path};
+  if (!f.open(QIODevice::WriteOnly) || f.write(json) != json.size())
+  {
+    QTextStream{stderr} << "Cannot write " << path << "\n";
+    return 1;
+  }
+  return 0;
+}
+}
@@ -0,0 +1,154 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "Application.hpp"
+#include "Benchmark.hpp"
+#include "GeneratedDocument.hpp"
+
+#include <score/application/GUIApplicationContext.hpp>
+
+#include <core/document/Document.hpp>
+#include <core/presenter/DocumentManager.hpp>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QJsonObject>
+#include <QTextStream>
+
+#include <SEGMent/ImageCache.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+
+/**
+ * Measures the loading of a generated SEGMent document.
+ *
+ * The canvas has to find the window of scenes and of objects
+ * when it creates the arrows of the transitions.
+ *
+ * * headless: the document is loaded without presenter nor view,
+ *   i.e. only the model is created.
+ * * view: the document is loaded like when opening a file,
+ *   with the canvas and all its windows and arrows.
+ * * events: the events posted while loading the view are processed.
+ *
+ * To compare two versions of the editor, run the benchmark built from each
+ * with the same parameters.
+ */
+namespace
+{
+using benchmark::measure;
+using benchmark::PhaseTimings;
+}
+
+int main(int argc, char** argv)
+{
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+
+  score::ApplicationSettings settings;
+  settings.tryToRestore = false;
+
+  Application app(settings, argc, argv);
+  score::setQApplicationMetadata();
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(QCoreApplication::translate(
+      "main", "Loads a generated document and reports the time spent."));
+  parser.addHelpOption();
+
+  QCommandLineOption scenesOpt(
+      "scenes",
+      QCoreApplication::translate("main", "Number of scenes"),
+      "count",
+      "500");
+  QCommandLineOption objectsOpt(
+      "objects",
+      QCoreApplication::translate("main", "Number of objects per scene"),
+      "count",
+      "2");
+  QCommandLineOption transitionsOpt(
+      "transitions",
+      QCoreApplication::translate("main", "Number of transitions"),
+      "count",
+      "2000");
+  QCommandLineOption outputOpt(
+      {"o", "output"},
+      QCoreApplication::translate(
+          "main", "Write the results to a file instead of stdout"),
+      "file");
+  QCommandLineOption iterationsOpt(
+      "iterations",
+      QCoreApplication::translate("main", "Number of loads"),
+      "count",
+      "5");
+  parser.addOption(scenesOpt);
+  parser.addOption(objectsOpt);
+  parser.addOption(transitionsOpt);
+  parser.addOption(outputOpt);
+  parser.addOption(iterationsOpt);
+  parser.process(QCoreApplication::arguments());
+
+  qRegisterMetaType<SEGMent::CacheInstance>();
+  qRegisterMetaTypeStreamOperators<SEGMent::CacheInstance>();
+  qRegisterMetaType<std::unordered_map<QString, SEGMent::CacheInstance>>();
+  qRegisterMetaTypeStreamOperators<
+      std::unordered_map<QString, SEGMent::CacheInstance>>();
+
+  QJsonObject results;
+  try
+  {
+    SEGMent::ImageCache cache;
+    SEGMent::ImageCache::self = &cache;
+
+    app.init();
+    auto& ctx = app.context();
+    auto& factory = *ctx.interfaces<score::DocumentDelegateList>().begin();
+
+    benchmark::DocumentParameters p;
+    p.scenes = std::max(0, parser.value(scenesOpt).toInt());
+    p.objects = std::max(0, parser.value(objectsOpt).toInt());
+    p.transitions = std::max(0, parser.value(transitionsOpt).toInt());
+    const int iterations = std::max(1, parser.value(iterationsOpt).toInt());
+
+    const QVariant data = benchmark::generateDocument(ctx, factory, p);
+
+    PhaseTimings load;
+    for (int i = 0; i < iterations; i++)
+    {
+      std::unique_ptr<score::Document> headless;
+      load["headless"].add(measure([&] {
+        headless.reset(
+            new score::Document{"benchmark", data, factory, nullptr});
+      }));
+      headless.reset();
+
+      score::Document* doc{};
+      load["view"].add(measure([&] {
+        doc = ctx.docManager.loadDocument(ctx, "benchmark", data, factory);
+      }));
+      if (!doc)
+        throw std::runtime_error("Cannot load the generated document");
+
+      load["events"].add(
+          measure([] { QCoreApplication::processEvents(); }));
+
+      ctx.docManager.forceCloseDocument(ctx, *doc);
+      QCoreApplication::processEvents();
+    }
+
+    results["load"] = benchmark::toJson(load);
+    results["scenes"] = p.scenes;
+    results["objects"] = p.objects;
+    results["transitions"] = p.transitions;
+    results["iterations"] = iterations;
+    results["qt"] = qVersion();
+  }
+  catch (const std::exception& e)
+  {
+    QTextStream{stderr} << e.what() << "\n";
+    return 1;
+  }
+
+  return benchmark::writeResults(results, parser.value(outputOpt));
+}
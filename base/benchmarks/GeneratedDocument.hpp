@@ -0,0 +1,112 @@
+#pragma once
+#include <score/application/GUIApplicationContext.hpp>
+#include <score/plugins/documentdelegate/DocumentDelegateFactory.hpp>
+
+#include <core/document/Document.hpp>
+#include <core/document/DocumentModel.hpp>
+#include <core/presenter/DocumentManager.hpp>
+
+#include <QVariant>
+
+#include <SEGMent/Document.hpp>
+#include <SEGMent/Model/ProcessModel.hpp>
+#include <SEGMent/Model/Scene.hpp>
+#include <SEGMent/Model/Transition.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+/**
+ * Generation of SEGMent documents for the benchmarks.
+ *
+ * The document has a given number of scenes, laid out on a grid, each with
+ * a few objects; the transitions alternate between scene-to-scene and
+ * object-to-scene transitions.
+ */
+namespace benchmark
+{
+struct DocumentParameters
+{
+  int scenes{};
+  int objects{};
+  int transitions{};
+};
+
+inline SEGMent::ProcessModel& processOf(const score::Document& doc)
+{
+  return static_cast<SEGMent::DocumentModel&>(doc.model().modelDelegate())
+      .process();
+}
+
+//! Replaces the content of the process with the generated one.
+inline void
+generate(SEGMent::ProcessModel& process, const DocumentParameters& p)
+{
+  using namespace SEGMent;
+  process.transitions.clear();
+  process.scenes.clear();
+
+  const int columns = std::max(1, int(std::ceil(std::sqrt(p.scenes))));
+
+  std::vector<SceneModel*> scenes;
+  for (int i = 0; i < p.scenes; i++)
+  {
+    auto scene = new SceneModel{Id<SceneModel>{i}, &process};
+    scene->setRect(
+        {(i % columns) * 800. - 10000., (i / columns) * 600. - 10000., 640,
+         480});
+    scenes.push_back(scene);
+    process.scenes.add(scene);
+
+    for (int j = 0; j < p.objects; j++)
+    {
+      auto obj = new ImageModel{Id<ImageModel>{j}, scene};
+      obj->setPos({0.1 + 0.8 * j / p.objects, 0.5});
+      obj->setSize({0.1, 0.1});
+      scene->objects().add(obj);
+    }
+  }
+
+  if (scenes.size() < 2)
+    return;
+
+  for (int i = 0; i < p.transitions; i++)
+  {
+    // Each transition goes further away than the previous ones
+    // from the same scene, so that no two are the same.
+    auto& from = *scenes[i % scenes.size()];
+    auto& to = *scenes[(i % scenes.size() + 1 + i / scenes.size())
+                       % scenes.size()];
+
+    transition_t t;
+    if (i % 2 == 0 || p.objects == 0)
+    {
+      t = SceneToScene{from, to, 2, 6};
+    }
+    else
+    {
+      auto& obj = *from.objects().begin();
+      t = ObjectToScene{obj, to, 4, 6};
+    }
+    process.transitions.add(
+        new TransitionModel{t, Id<TransitionModel>{i}, &process});
+  }
+}
+
+//! Generates a document without view and returns its save data,
+//! which can be loaded like a file.
+inline QVariant generateDocument(
+    const score::GUIApplicationContext& ctx,
+    score::DocumentDelegateFactory& factory,
+    const DocumentParameters& p)
+{
+  score::Document doc{
+      "generated",
+      ctx.docManager.currentDocument()->saveAsByteArray(),
+      factory,
+      nullptr};
+  generate(processOf(doc), p);
+  return doc.saveAsJson();
+}
+}
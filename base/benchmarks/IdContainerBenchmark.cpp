@@ -0,0 +1,176 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "Benchmark.hpp"
+
+#include <score/model/IdentifiedObject.hpp>
+#include <score/model/IdentifiedObjectMap.hpp>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QJsonObject>
+
+#include <tsl/hopscotch_map.h>
+
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <random>
+#include <vector>
+
+/**
+ * Measures the operations of IdContainer, the storage of EntityMap:
+ *
+ * * insert: all the elements are inserted in an empty container.
+ * * find: each element is looked up once, in random order.
+ * * iterate: the container is iterated over in full.
+ * * erase: each element is removed once, in random order.
+ *
+ * The same operations are measured on a list-based container, laid out
+ * like IdContainer was before it stored its elements in a vector, which
+ * gives the baseline in the same run.
+ */
+namespace
+{
+using benchmark::measure;
+using benchmark::PhaseTimings;
+
+class Element final : public IdentifiedObject<Element>
+{
+public:
+  explicit Element(Id<Element> id)
+      : IdentifiedObject<Element>{std::move(id), "Element", nullptr}
+  {
+  }
+};
+
+int32_t idOf(const Element& e) noexcept
+{
+  return e.id_val();
+}
+int32_t idOf(const Element* e) noexcept
+{
+  return e->id_val();
+}
+
+//! The former layout: elements in a list, and a map of list iterators.
+struct ListContainer
+{
+  std::list<Element*> order;
+  tsl::hopscotch_map<Id<Element>, std::list<Element*>::iterator> map;
+
+  void insert(Element* e)
+  {
+    order.push_front(e);
+    map.insert({e->id(), order.begin()});
+  }
+
+  std::list<Element*>::const_iterator find(const Id<Element>& id) const
+  {
+    auto it = map.find(id);
+    return it != map.end() ? it->second : order.end();
+  }
+
+  void remove(const Id<Element>& id)
+  {
+    auto it = map.find(id);
+    order.erase(it->second);
+    map.erase(it);
+  }
+
+  auto begin() const { return order.cbegin(); }
+  auto end() const { return order.cend(); }
+};
+
+template <typename Container>
+void run(
+    const QString& name,
+    const std::vector<Element*>& elements,
+    const std::vector<Id<Element>>& shuffled,
+    PhaseTimings& timings)
+{
+  Container c;
+  timings[name + "/insert"].add(measure([&] {
+    for (auto e : elements)
+      c.insert(e);
+  }));
+
+  int found = 0;
+  timings[name + "/find"].add(measure([&] {
+    for (const auto& id : shuffled)
+      found += c.find(id) != c.end();
+  }));
+
+  int32_t sum = 0;
+  timings[name + "/iterate"].add(measure([&] {
+    for (const auto& e : c)
+      sum += idOf(e);
+  }));
+
+  timings[name + "/erase"].add(measure([&] {
+    for (const auto& id : shuffled)
+      c.remove(id);
+  }));
+
+  // Keeps the loops from being optimized away
+  if (found != int(elements.size()) || sum < 0)
+    qFatal("Unexpected result");
+}
+}
+
+int main(int argc, char** argv)
+{
+  QCoreApplication app(argc, argv);
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(QCoreApplication::translate(
+      "main", "Measures the operations of IdContainer."));
+  parser.addHelpOption();
+
+  QCommandLineOption elementsOpt(
+      "elements",
+      QCoreApplication::translate("main", "Number of elements"),
+      "count",
+      "10000");
+  QCommandLineOption outputOpt(
+      {"o", "output"},
+      QCoreApplication::translate(
+          "main", "Write the results to a file instead of stdout"),
+      "file");
+  QCommandLineOption iterationsOpt(
+      "iterations",
+      QCoreApplication::translate("main", "Number of runs"),
+      "count",
+      "20");
+  parser.addOption(elementsOpt);
+  parser.addOption(outputOpt);
+  parser.addOption(iterationsOpt);
+  parser.process(app);
+
+  const int n = std::max(1, parser.value(elementsOpt).toInt());
+  const int iterations = std::max(1, parser.value(iterationsOpt).toInt());
+
+  std::vector<std::unique_ptr<Element>> storage;
+  std::vector<Element*> elements;
+  std::vector<Id<Element>> shuffled;
+  for (int i = 0; i < n; i++)
+  {
+    storage.emplace_back(new Element{Id<Element>{i}});
+    elements.push_back(storage.back().get());
+    shuffled.push_back(Id<Element>{i});
+  }
+  std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937{1234});
+
+  PhaseTimings timings;
+  for (int i = 0; i < iterations; i++)
+  {
+    run<IdContainer<Element>>("IdContainer", elements, shuffled, timings);
+    run<ListContainer>("list", elements, shuffled, timings);
+  }
+
+  QJsonObject results;
+  results["operations"] = benchmark::toJson(timings);
+  results["elements"] = n;
+  results["iterations"] = iterations;
+  results["qt"] = qVersion();
+  return benchmark::writeResults(results, parser.value(outputOpt));
+}
@@ -0,0 +1,230 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "Application.hpp"
+#include "Benchmark.hpp"
+
+#include <score/application/GUIApplicationContext.hpp>
+#include <score/document/DocumentInterface.hpp>
+#include <score/model/EntityMap.hpp>
+#include <score/model/IdentifiedObject.hpp>
+#include <score/model/path/ObjectPath.hpp>
+#include <score/plugins/documentdelegate/DocumentDelegateFactory.hpp>
+#include <score/plugins/documentdelegate/DocumentDelegateModel.hpp>
+
+#include <core/document/Document.hpp>
+#include <core/document/DocumentModel.hpp>
+#include <core/presenter/DocumentManager.hpp>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QJsonObject>
+#include <QTextStream>
+
+#include <SEGMent/ImageCache.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Measures the resolution of object paths in two generated trees.
+ *
+ * Each level of a tree has a given number of nodes, which are children of
+ * the first node of the level above:
+ *
+ * * deep: many levels with a few nodes each.
+ * * wide: two levels with many nodes each.
+ *
+ * The path of every node of the tree is resolved:
+ *
+ * * registry: through ObjectPath::find, as commands do, without the cache
+ *   of the path.
+ * * qobject: by walking the QObject hierarchy with findChildren, like
+ *   ObjectPath did before it used the IdentityRegistry; this gives the
+ *   baseline in the same run.
+ *
+ * The trees are children of the model of a document without view, like
+ * the processes of a SEGMent document.
+ */
+namespace
+{
+using benchmark::measure;
+using benchmark::PhaseTimings;
+
+class Node final : public IdentifiedObject<Node>
+{
+public:
+  Node(Id<Node> id, QObject* parent)
+      : IdentifiedObject<Node>{std::move(id), "Node", parent}
+  {
+  }
+
+  score::EntityMap<Node> children;
+};
+
+struct Tree
+{
+  QString name;
+  int depth{};
+  int width{};
+};
+
+QObject* findByWalk(QObject* obj, const ObjectPath& path)
+{
+  for (const auto& id : path.vec())
+  {
+    const auto children = obj->findChildren<IdentifiedObjectAbstract*>(
+        id.objectName(), Qt::FindDirectChildrenOnly);
+    auto it = std::find_if(children.begin(), children.end(), [&](auto c) {
+      return c->id_val() == id.id();
+    });
+    if (it == children.end())
+      throw std::runtime_error("Path not found");
+    obj = *it;
+  }
+  return obj;
+}
+
+void run(
+    const Tree& tree,
+    const score::Document& doc,
+    int iterations,
+    PhaseTimings& timings)
+{
+  auto& model = doc.model().modelDelegate();
+  score::EntityMap<Node> roots;
+
+  std::vector<Node*> nodes;
+  QObject* parent = &model;
+  auto* map = &roots;
+  for (int level = 0; level < tree.depth; level++)
+  {
+    Node* first{};
+    for (int i = 0; i < tree.width; i++)
+    {
+      auto n = new Node{Id<Node>{i}, parent};
+      map->add(n);
+      nodes.push_back(n);
+      if (!first)
+        first = n;
+    }
+    parent = first;
+    map = &first->children;
+  }
+
+  std::vector<ObjectPath> paths;
+  paths.reserve(nodes.size());
+  for (auto node : nodes)
+    paths.push_back(score::IDocument::unsafe_path(*node));
+
+  for (int i = 0; i < iterations; i++)
+  {
+    // Copies do not share the cache of the original path
+    std::vector<ObjectPath> uncached{paths.begin(), paths.end()};
+    timings[tree.name + "/registry"].add(measure([&] {
+      for (const auto& path : uncached)
+        path.find<Node>(doc.context());
+    }));
+
+    timings[tree.name + "/qobject"].add(measure([&] {
+      for (const auto& path : paths)
+        findByWalk(&doc.model(), path);
+    }));
+  }
+
+  // Removes the tree from the document before the next one is built
+  roots.clear();
+}
+}
+
+int main(int argc, char** argv)
+{
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+
+  score::ApplicationSettings settings;
+  settings.tryToRestore = false;
+
+  Application app(settings, argc, argv);
+  score::setQApplicationMetadata();
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(QCoreApplication::translate(
+      "main",
+      "Resolves paths in generated trees and reports the time spent."));
+  parser.addHelpOption();
+
+  QCommandLineOption depthOpt(
+      "depth",
+      QCoreApplication::translate(
+          "main", "Number of levels of the deep tree"),
+      "count",
+      "32");
+  QCommandLineOption widthOpt(
+      "width",
+      QCoreApplication::translate(
+          "main", "Number of nodes per level in the wide tree"),
+      "count",
+      "2000");
+  QCommandLineOption outputOpt(
+      {"o", "output"},
+      QCoreApplication::translate(
+          "main", "Write the results to a file instead of stdout"),
+      "file");
+  QCommandLineOption iterationsOpt(
+      "iterations",
+      QCoreApplication::translate(
+          "main", "Number of resolutions of each path"),
+      "count",
+      "10");
+  parser.addOption(depthOpt);
+  parser.addOption(widthOpt);
+  parser.addOption(outputOpt);
+  parser.addOption(iterationsOpt);
+  parser.process(QCoreApplication::arguments());
+
+  qRegisterMetaType<SEGMent::CacheInstance>();
+  qRegisterMetaTypeStreamOperators<SEGMent::CacheInstance>();
+  qRegisterMetaType<std::unordered_map<QString, SEGMent::CacheInstance>>();
+  qRegisterMetaTypeStreamOperators<
+      std::unordered_map<QString, SEGMent::CacheInstance>>();
+
+  QJsonObject results;
+  try
+  {
+    SEGMent::ImageCache cache;
+    SEGMent::ImageCache::self = &cache;
+
+    app.init();
+    auto& ctx = app.context();
+    auto& factory = *ctx.interfaces<score::DocumentDelegateList>().begin();
+
+    const int depth = std::max(1, parser.value(depthOpt).toInt());
+    const int width = std::max(1, parser.value(widthOpt).toInt());
+    const int iterations = std::max(1, parser.value(iterationsOpt).toInt());
+
+    std::unique_ptr<score::Document> doc{new score::Document{
+        "benchmark",
+        ctx.docManager.currentDocument()->saveAsByteArray(),
+        factory,
+        nullptr}};
+
+    PhaseTimings timings;
+    run({"deep", depth, 16}, *doc, iterations, timings);
+    run({"wide", 2, width}, *doc, iterations, timings);
+
+    results["resolve"] = benchmark::toJson(timings);
+    results["depth"] = depth;
+    results["width"] = width;
+    results["iterations"] = iterations;
+    results["qt"] = qVersion();
+  }
+  catch (const std::exception& e)
+  {
+    QTextStream{stderr} << e.what() << "\n";
+    return 1;
+  }
+
+  return benchmark::writeResults(results, parser.value(outputOpt));
+}
@@ -0,0 +1,248 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "Application.hpp"
+#include "Benchmark.hpp"
+
+#include <score/application/ApplicationComponents.hpp>
+#include <score/application/GUIApplicationContext.hpp>
+#include <score/command/Command.hpp>
+#include <score/command/CommandData.hpp>
+#include <score/plugins/customfactory/StringFactoryKeySerialization.hpp>
+#include <score/plugins/documentdelegate/DocumentDelegateFactory.hpp>
+#include <score/serialization/DataStreamVisitor.hpp>
+
+#include <core/command/CommandStack.hpp>
+#include <core/document/Document.hpp>
+#include <core/presenter/DocumentManager.hpp>
+
+#include <QCommandLineParser>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+
+#include <SEGMent/ImageCache.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Replays a command stack saved with DocumentManager::saveStack.
+ *
+ * The commands are applied to a document which has no view, hence only the
+ * cost of the model and of the command stack is measured:
+ *
+ * * push: each command is redone and pushed once, in the recorded order.
+ * * undo, redo: the whole stack is undone, then redone, one command at a time.
+ * * jump: the stack jumps between its first, middle and last index.
+ *
+ * The application itself still needs a platform plug-in for the
+ * GUI application plug-ins; it defaults to offscreen.
+ */
+namespace
+{
+using benchmark::measure;
+using benchmark::PhaseTimings;
+
+QString commandName(const score::Command& cmd)
+{
+  return QString::fromStdString(cmd.parentKey().toString()) + "::"
+         + QString::fromStdString(cmd.key().toString());
+}
+
+//! The commands in the order in which they were applied
+std::vector<score::Command*> readStack(
+    const score::ApplicationComponents& components,
+    const QString& path)
+{
+  QFile f{path};
+  if (!f.open(QIODevice::ReadOnly))
+    throw std::runtime_error("Cannot open " + path.toStdString());
+
+  const QByteArray data = f.readAll();
+  DataStream::Deserializer writer{data};
+
+  // Same format as DocumentManager::loadStack
+  Id<score::DocumentModel> id;
+  std::vector<score::CommandData> undoStack, redoStack;
+  writer.writeTo(id);
+  writer.writeTo(undoStack);
+  writer.writeTo(redoStack);
+  writer.checkDelimiter();
+
+  std::vector<score::Command*> commands;
+  commands.reserve(undoStack.size() + redoStack.size());
+  for (const auto& cmd : undoStack)
+    commands.push_back(components.instantiateUndoCommand(cmd));
+
+  // The top of the redo stack is the next command to redo.
+  for (auto it = redoStack.rbegin(); it != redoStack.rend(); ++it)
+    commands.push_back(components.instantiateUndoCommand(*it));
+
+  return commands;
+}
+
+QVariant readDocument(const QString& path)
+{
+  QFile f{path};
+  if (!f.open(QIODevice::ReadOnly))
+    throw std::runtime_error("Cannot open " + path.toStdString());
+
+  QJsonParseError err;
+  auto json = QJsonDocument::fromJson(f.readAll(), &err);
+  if (err.error != QJsonParseError::NoError)
+    throw std::runtime_error(
+        path.toStdString() + ": " + err.errorString().toStdString());
+
+  return json.object();
+}
+
+struct StackReplay
+{
+  score::CommandStack& stack;
+
+  PhaseTimings push, undo, redo, jump;
+
+  void run(const std::vector<score::Command*>& commands, int iterations)
+  {
+    for (auto cmd : commands)
+    {
+      push[commandName(*cmd)].add(
+          measure([&] { stack.redoAndPushQuiet(cmd); }));
+    }
+
+    const int n = stack.size();
+    for (int i = 0; i < iterations; i++)
+    {
+      while (stack.canUndo())
+      {
+        auto name = commandName(*stack.undoable().top());
+        undo[name].add(measure([&] { stack.undoQuiet(); }));
+      }
+
+      while (stack.canRedo())
+      {
+        auto name = commandName(*stack.redoable().top());
+        redo[name].add(measure([&] { stack.redoQuiet(); }));
+      }
+
+      for (int index : {0, n, n / 2, 0, n / 2, n})
+      {
+        auto name = QString("%1->%2").arg(stack.currentIndex()).arg(index);
+        jump[name].add(measure([&] { stack.setIndexQuiet(index); }));
+      }
+    }
+  }
+
+  QJsonObject toJson() const
+  {
+    QJsonObject obj;
+    obj["push"] = benchmark::toJson(push);
+    obj["undo"] = benchmark::toJson(undo);
+    obj["redo"] = benchmark::toJson(redo);
+    obj["jump"] = benchmark::toJson(jump);
+    return obj;
+  }
+};
+}
+
+int main(int argc, char** argv)
+{
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+
+  score::ApplicationSettings settings;
+  settings.tryToRestore = false;
+
+  Application app(settings, argc, argv);
+  score::setQApplicationMetadata();
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(QCoreApplication::translate(
+      "main",
+      "Replays a command stack and reports the time spent in each command."));
+  parser.addHelpOption();
+  parser.addPositionalArgument(
+      "stack",
+      QCoreApplication::translate("main", "Command stack (.stack) to replay"));
+
+  QCommandLineOption documentOpt(
+      "document",
+      QCoreApplication::translate(
+          "main", "Document on which the stack was recorded (.segment)"),
+      "file");
+  QCommandLineOption outputOpt(
+      {"o", "output"},
+      QCoreApplication::translate(
+          "main", "Write the results to a file instead of stdout"),
+      "file");
+  QCommandLineOption iterationsOpt(
+      "iterations",
+      QCoreApplication::translate(
+          "main", "Number of undo / redo / jump cycles"),
+      "count",
+      "10");
+  parser.addOption(documentOpt);
+  parser.addOption(outputOpt);
+  parser.addOption(iterationsOpt);
+  parser.process(QCoreApplication::arguments());
+
+  const auto args = parser.positionalArguments();
+  if (args.size() != 1)
+    parser.showHelp(1);
+
+  qRegisterMetaType<SEGMent::CacheInstance>();
+  qRegisterMetaTypeStreamOperators<SEGMent::CacheInstance>();
+  qRegisterMetaType<std::unordered_map<QString, SEGMent::CacheInstance>>();
+  qRegisterMetaTypeStreamOperators<
+      std::unordered_map<QString, SEGMent::CacheInstance>>();
+
+  QJsonObject results;
+  try
+  {
+    SEGMent::ImageCache cache;
+    SEGMent::ImageCache::self = &cache;
+
+    app.init();
+    auto& ctx = app.context();
+
+    // Without a base document, the stack is replayed on a new document
+    // like DocumentManager::loadStack does.
+    QVariant base;
+    if (parser.isSet(documentOpt))
+      base = readDocument(parser.value(documentOpt));
+    else
+      base = ctx.docManager.currentDocument()->saveAsByteArray();
+
+    auto& factory = *ctx.interfaces<score::DocumentDelegateList>().begin();
+
+    QElapsedTimer load;
+    load.start();
+    std::unique_ptr<score::Document> doc{
+        new score::Document{"benchmark", base, factory, nullptr}};
+    const qint64 load_ns = load.nsecsElapsed();
+
+    const auto commands = readStack(ctx.components, args.front());
+    const int iterations = std::max(1, parser.value(iterationsOpt).toInt());
+
+    StackReplay replay{doc->commandStack()};
+    replay.run(commands, iterations);
+
+    results = replay.toJson();
+    results["stack"] = args.front();
+    results["document"] = parser.value(documentOpt);
+    results["commands"] = int(commands.size());
+    results["iterations"] = iterations;
+    results["load_ns"] = load_ns;
+    results["qt"] = qVersion();
+  }
+  catch (const std::exception& e)
+  {
+    QTextStream{stderr} << e.what() << "\n";
+    return 1;
+  }
+
+  return benchmark::writeResults(results, parser.value(outputOpt));
+}
@@ -0,0 +1,261 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "Application.hpp"
+#include "Benchmark.hpp"
+#include "GeneratedDocument.hpp"
+
+#include <score/application/GUIApplicationContext.hpp>
+#include <score/model/path/PathSerialization.hpp>
+#include <score/serialization/DataStreamVisitor.hpp>
+
+#include <core/document/Document.hpp>
+
+#include <QBuffer>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QJsonObject>
+#include <QTextStream>
+
+#include <SEGMent/ImageCache.hpp>
+#include <SEGMent/StringUtils.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Measures the conversions of the paths of the transitions of a generated
+ * document, i.e. of both endpoints of each transition:
+ *
+ * * string/write, string/read: pathToString and pathFromString, used
+ *   by the JSON format.
+ * * compact/write, compact/read: writeCompactPath and readCompactPath,
+ *   used by the DataStream format.
+ * * objectpath/write, objectpath/read: the DataStream serialization of
+ *   ObjectPath, which was used before the compact form and is still read.
+ *
+ * The whole document is also saved to and loaded from a file in memory,
+ * in both formats: save/json, save/binary, load/json, load/binary.
+ */
+namespace
+{
+using benchmark::measure;
+using benchmark::PhaseTimings;
+
+struct Endpoints
+{
+  std::vector<Path<SEGMent::SceneModel>> scenes;
+  std::vector<Path<SEGMent::ImageModel>> objects;
+};
+
+Endpoints endpoints(const SEGMent::ProcessModel& process)
+{
+  using namespace SEGMent;
+  Endpoints e;
+  for (const TransitionModel& t : process.transitions)
+  {
+    if (auto s = t.transition().target<SceneToScene>())
+    {
+      e.scenes.push_back(s->from);
+      e.scenes.push_back(s->to);
+    }
+    else if (auto o = t.transition().target<ObjectToScene>())
+    {
+      e.objects.push_back(o->from);
+      e.scenes.push_back(o->to);
+    }
+  }
+  return e;
+}
+
+template <typename T>
+void runString(const std::vector<Path<T>>& paths, PhaseTimings& timings)
+{
+  std::vector<QString> strings(paths.size());
+  timings["string/write"].add(measure([&] {
+    for (std::size_t i = 0; i < paths.size(); i++)
+      strings[i] = SEGMent::pathToString(paths[i]);
+  }));
+
+  std::vector<Path<T>> read(paths.size());
+  timings["string/read"].add(measure([&] {
+    for (std::size_t i = 0; i < strings.size(); i++)
+      read[i] = SEGMent::pathFromString<T>(strings[i]);
+  }));
+
+  if (read != paths)
+    throw std::runtime_error("pathFromString: wrong result");
+}
+
+template <typename T>
+void runCompact(const std::vector<Path<T>>& paths, PhaseTimings& timings)
+{
+  QByteArray data;
+  {
+    QDataStream s{&data, QIODevice::WriteOnly};
+    timings["compact/write"].add(measure([&] {
+      for (const auto& path : paths)
+        SEGMent::writeCompactPath(s, path);
+    }));
+  }
+
+  std::vector<Path<T>> read(paths.size());
+  {
+    QDataStream s{data};
+    timings["compact/read"].add(measure([&] {
+      for (auto& path : read)
+        SEGMent::readCompactPath(s, path);
+    }));
+  }
+
+  if (read != paths)
+    throw std::runtime_error("readCompactPath: wrong result");
+}
+
+template <typename T>
+void runObjectPath(const std::vector<Path<T>>& paths, PhaseTimings& timings)
+{
+  QByteArray data;
+  {
+    DataStream::Serializer s{&data};
+    timings["objectpath/write"].add(measure([&] {
+      for (const auto& path : paths)
+        s.readFrom(path);
+    }));
+  }
+
+  std::vector<Path<T>> read(paths.size());
+  {
+    DataStream::Deserializer s{data};
+    timings["objectpath/read"].add(measure([&] {
+      for (auto& path : read)
+        s.writeTo(path);
+    }));
+  }
+
+  if (read != paths)
+    throw std::runtime_error("ObjectPath serialization: wrong result");
+}
+
+template <typename T>
+void run(const std::vector<Path<T>>& paths, PhaseTimings& timings)
+{
+  runString(paths, timings);
+  runCompact(paths, timings);
+  runObjectPath(paths, timings);
+}
+}
+
+int main(int argc, char** argv)
+{
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+
+  score::ApplicationSettings settings;
+  settings.tryToRestore = false;
+
+  Application app(settings, argc, argv);
+  score::setQApplicationMetadata();
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(QCoreApplication::translate(
+      "main",
+      "Converts the paths of the transitions of a generated document and "
+      "reports the time spent."));
+  parser.addHelpOption();
+
+  QCommandLineOption scenesOpt(
+      "scenes",
+      QCoreApplication::translate("main", "Number of scenes"),
+      "count",
+      "500");
+  QCommandLineOption transitionsOpt(
+      "transitions",
+      QCoreApplication::translate("main", "Number of transitions"),
+      "count",
+      "10000");
+  QCommandLineOption outputOpt(
+      {"o", "output"},
+      QCoreApplication::translate(
+          "main", "Write the results to a file instead of stdout"),
+      "file");
+  QCommandLineOption iterationsOpt(
+      "iterations",
+      QCoreApplication::translate("main", "Number of runs"),
+      "count",
+      "10");
+  parser.addOption(scenesOpt);
+  parser.addOption(transitionsOpt);
+  parser.addOption(outputOpt);
+  parser.addOption(iterationsOpt);
+  parser.process(QCoreApplication::arguments());
+
+  qRegisterMetaType<SEGMent::CacheInstance>();
+  qRegisterMetaTypeStreamOperators<SEGMent::CacheInstance>();
+  qRegisterMetaType<std::unordered_map<QString, SEGMent::CacheInstance>>();
+  qRegisterMetaTypeStreamOperators<
+      std::unordered_map<QString, SEGMent::CacheInstance>>();
+
+  QJsonObject results;
+  try
+  {
+    SEGMent::ImageCache cache;
+    SEGMent::ImageCache::self = &cache;
+
+    app.init();
+    auto& ctx = app.context();
+    auto& factory = *ctx.interfaces<score::DocumentDelegateList>().begin();
+
+    benchmark::DocumentParameters p;
+    p.scenes = std::max(0, parser.value(scenesOpt).toInt());
+    p.objects = 1;
+    p.transitions = std::max(0, parser.value(transitionsOpt).toInt());
+    const int iterations = std::max(1, parser.value(iterationsOpt).toInt());
+
+    const QVariant json = benchmark::generateDocument(ctx, factory, p);
+    std::unique_ptr<score::Document> doc{
+        new score::Document{"benchmark", json, factory, nullptr}};
+    const auto paths = endpoints(benchmark::processOf(*doc));
+
+    PhaseTimings timings;
+    QByteArray text, binary;
+    for (int i = 0; i < iterations; i++)
+    {
+      run(paths.scenes, timings);
+      run(paths.objects, timings);
+
+      timings["save/json"].add(measure([&] {
+        QBuffer buf{&text};
+        buf.open(QIODevice::WriteOnly);
+        doc->saveAsJson(buf);
+      }));
+      timings["save/binary"].add(measure([&] {
+        QBuffer buf{&binary};
+        buf.open(QIODevice::WriteOnly);
+        doc->saveAsBinary(buf);
+      }));
+
+      timings["load/json"].add(measure([&] {
+        score::Document{"benchmark", text, factory, nullptr};
+      }));
+      timings["load/binary"].add(measure([&] {
+        score::Document{"benchmark", binary, factory, nullptr};
+      }));
+    }
+
+    results["paths"] = benchmark::toJson(timings);
+    results["endpoints"] = int(paths.scenes.size() + paths.objects.size());
+    results["transitions"] = p.transitions;
+    results["iterations"] = iterations;
+    results["qt"] = qVersion();
+  }
+  catch (const std::exception& e)
+  {
+    QTextStream{stderr} << e.what() << "\n";
+    return 1;
+  }
+
+  return benchmark::writeResults(results, parser.value(outputOpt));
+}
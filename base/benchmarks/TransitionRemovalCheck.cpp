@@ -0,0 +1,128 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "Application.hpp"
+#include "GeneratedDocument.hpp"
+
+#include <score/application/GUIApplicationContext.hpp>
+#include <score/command/Dispatchers/MacroCommandDispatcher.hpp>
+
+#include <core/command/CommandStack.hpp>
+#include <core/document/Document.hpp>
+
+#include <QCoreApplication>
+#include <QTextStream>
+
+#include <SEGMent/Commands/Deletion.hpp>
+#include <SEGMent/ImageCache.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+
+/**
+ * Checks that removing an object also removes the transitions which start
+ * from it, and that undoing the removal brings them back.
+ *
+ * Runs on a generated document without view; exits with 1 on failure.
+ */
+namespace
+{
+bool hasTransition(
+    const SEGMent::ProcessModel& process,
+    const Id<SEGMent::TransitionModel>& id)
+{
+  for (const auto& t : process.transitions)
+  {
+    if (t.id() == id)
+      return true;
+  }
+  return false;
+}
+
+void check(bool ok, const char* what)
+{
+  if (!ok)
+    throw std::runtime_error(what);
+}
+}
+
+int main(int argc, char** argv)
+{
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+
+  score::ApplicationSettings settings;
+  settings.tryToRestore = false;
+
+  Application app(settings, argc, argv);
+  score::setQApplicationMetadata();
+
+  qRegisterMetaType<SEGMent::CacheInstance>();
+  qRegisterMetaTypeStreamOperators<SEGMent::CacheInstance>();
+  qRegisterMetaType<std::unordered_map<QString, SEGMent::CacheInstance>>();
+  qRegisterMetaTypeStreamOperators<
+      std::unordered_map<QString, SEGMent::CacheInstance>>();
+
+  try
+  {
+    using namespace SEGMent;
+    ImageCache cache;
+    ImageCache::self = &cache;
+
+    app.init();
+    auto& ctx = app.context();
+    auto& factory = *ctx.interfaces<score::DocumentDelegateList>().begin();
+
+    benchmark::DocumentParameters p;
+    p.scenes = 4;
+    p.objects = 1;
+    p.transitions = 8;
+    std::unique_ptr<score::Document> doc{new score::Document{
+        "check", benchmark::generateDocument(ctx, factory, p), factory,
+        nullptr}};
+    auto& process = benchmark::processOf(*doc);
+
+    // The first object-to-scene transition, and the object it starts from
+    const TransitionModel* trans{};
+    for (const auto& t : process.transitions)
+    {
+      if (t.transition().target<ObjectToScene>())
+      {
+        trans = &t;
+        break;
+      }
+    }
+    check(trans, "No object-to-scene transition was generated");
+
+    const auto id = trans->id();
+    auto& obj = trans->transition().target<ObjectToScene>()->from.find(
+        doc->context());
+    const auto outgoing = process.outgoingTransitions(obj);
+    check(
+        std::find(outgoing.begin(), outgoing.end(), trans) != outgoing.end(),
+        "The transition is not found from its object");
+
+    {
+      MacroCommandDispatcher<RemoveObjects> disp{doc->context().commandStack};
+      RemoveObjectVisitor vis{disp};
+      vis(obj);
+      vis.finish();
+      disp.commit();
+    }
+    check(
+        !hasTransition(process, id),
+        "The transition was not removed with its object");
+
+    doc->commandStack().undo();
+    check(
+        hasTransition(process, id),
+        "The transition did not come back when undoing");
+  }
+  catch (const std::exception& e)
+  {
+    QTextStream{stderr} << e.what() << "\n";
+    return 1;
+  }
+
+  return 0;
+}
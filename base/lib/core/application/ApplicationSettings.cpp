@@ -37,6 +37,28 @@ void ApplicationSettings::parse(QStringList cargs, int& argc, char** argv)
       QCoreApplication::translate("main", "Auto-play the loaded scenario"));
   parser.addOption(autoplayOpt);
 
+  QCommandLineOption compactJsonOpt(
+      "compact-json",
+      QCoreApplication::translate(
+          "main", "Save the documents without indentation"));
+  parser.addOption(compactJsonOpt);
+
+  QCommandLineOption undoMemoryOpt(
+      "undo-memory",
+      QCoreApplication::translate(
+          "main", "Memory used by the undo history of a document, in MB"),
+      "megabytes");
+  parser.addOption(undoMemoryOpt);
+
+  QCommandLineOption backupSyncOpt(
+      "backup-sync",
+      QCoreApplication::translate(
+          "main",
+          "When the crash-recovery data is synced to the disk: "
+          "never, checkpoints or always"),
+      "policy");
+  parser.addOption(backupSyncOpt);
+
   if (cargs.contains("--help") || cargs.contains("--version"))
   {
     QCoreApplication app(argc, argv);
@@ -56,6 +78,26 @@ void ApplicationSettings::parse(QStringList cargs, int& argc, char** argv)
   if (!gui)
     tryToRestore = false;
   autoplay = parser.isSet(autoplayOpt) && args.size() == 1;
+  compactJson = parser.isSet(compactJsonOpt);
+
+  if (parser.isSet(undoMemoryOpt))
+  {
+    bool ok = false;
+    const auto mb = parser.value(undoMemoryOpt).toLongLong(&ok);
+    if (ok && mb >= 0)
+      undoMemoryBudget = mb * 1024 * 1024;
+  }
+
+  if (parser.isSet(backupSyncOpt))
+  {
+    const auto policy = parser.value(backupSyncOpt);
+    if (policy == "never")
+      backupSync = BackupSync::Never;
+    else if (policy == "checkpoints")
+      backupSync = BackupSync::Checkpoints;
+    else if (policy == "always")
+      backupSync = BackupSync::Always;
+  }
 
   if (!args.empty() && QFile::exists(args[0]))
   {
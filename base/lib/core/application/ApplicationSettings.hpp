@@ -27,6 +27,23 @@ struct SCORE_LIB_BASE_EXPORT ApplicationSettings
   //! The version of the base score framework's JSON save file.
   score::Version saveFormatVersion{2};
 
+  //! If true, the documents are saved without indentation.
+  bool compactJson = false;
+
+  //! Memory in bytes that the compressed undo history of a document can
+  //! use before being moved to the disk.
+  qint64 undoMemoryBudget = 64 * 1024 * 1024;
+
+  //! When the crash-recovery journal of the documents is synced to the
+  //! disk: never, only on checkpoints, or after each record.
+  enum class BackupSync
+  {
+    Never,
+    Checkpoints,
+    Always
+  };
+  BackupSync backupSync = BackupSync::Checkpoints;
+
   //! List of scenarios that should be loaded
   QStringList loadList;
 
@@ -2,31 +2,59 @@
 // it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 #include "CommandBackupFile.hpp"
 
+#include <score/application/ApplicationContext.hpp>
 #include <score/command/Command.hpp>
+#include <score/plugins/customfactory/StringFactoryKeySerialization.hpp>
 #include <score/serialization/DataStreamVisitor.hpp>
 #include <score/tools/Todo.hpp>
 
 #include <core/command/CommandStack.hpp>
 
+#include <QDataStream>
+
+#include <vector>
+
+#if defined(_WIN32)
+#include <io.h>
+#elif !defined(__EMSCRIPTEN__)
+#include <unistd.h>
+#endif
+
 namespace score
 {
-CommandStackBackup::CommandStackBackup(const CommandStack& stack)
+namespace
 {
-  // Load initial state
-  for (const auto& cmd : stack.m_undoable)
-  {
-    savedUndo.push(CommandData{*cmd});
-  }
-  for (const auto& cmd : stack.m_redoable)
-  {
-    savedRedo.push(CommandData{*cmd});
-  }
+// Written at the beginning of the journal. Older backups contain
+// the serialized command stack directly.
+constexpr quint32 journalMagic = 0x53454a31;
+
+enum Record : quint8
+{
+  Checkpoint,
+  Push,
+  Merge,
+  Undo,
+  Redo,
+  Index
+};
+
+void syncToDisk(QFileDevice& f)
+{
+  f.flush();
+#if defined(_WIN32)
+  _commit(f.handle());
+#elif !defined(__EMSCRIPTEN__)
+  ::fsync(f.handle());
+#endif
+}
 }
 
 CommandBackupFile::CommandBackupFile(
     const score::CommandStack& stack,
     QObject* parent)
-    : QObject{parent}, m_stack{stack}, m_backup{m_stack}
+    : QObject{parent}
+    , m_stack{stack}
+    , m_sync{score::AppContext().applicationSettings.backupSync}
 {
   m_file.open();
 
@@ -34,13 +62,14 @@ CommandBackupFile::CommandBackupFile(
   con(m_stack, &CommandStack::sig_push, this, &CommandBackupFile::on_push);
   con(m_stack, &CommandStack::sig_undo, this, &CommandBackupFile::on_undo);
   con(m_stack, &CommandStack::sig_redo, this, &CommandBackupFile::on_redo);
+  con(m_stack, &CommandStack::sig_merge, this, &CommandBackupFile::on_merge);
   con(m_stack,
       &CommandStack::sig_indexChanged,
       this,
       &CommandBackupFile::on_indexChanged);
 
   // Initial backup so that the file is always in a loadable state.
-  commit();
+  checkpoint();
 }
 
 QString CommandBackupFile::fileName() const
@@ -50,80 +79,175 @@ QString CommandBackupFile::fileName() const
 
 void CommandBackupFile::on_push()
 {
-  /*
-  // A new command is added to m_undoable
-  // m_redoable should be cleared
-  auto cmd = m_stack.m_undoable.last();
-  m_backup.savedUndo.push(CommandData{*cmd});
-
-  m_backup.savedRedo.clear();
-
-  m_previousIndex = m_stack.currentIndex();
-  */
-  commit();
+  // A new command is added to m_undoable, m_redoable is cleared
+  append(Push, DataStream::Serializer::marshall(
+                   CommandData{*m_stack.undoable().top()}));
 }
 
 void CommandBackupFile::on_undo()
 {
-  /*
   // Pop from undoable to redoable
-  m_backup.savedRedo.push(m_savedUndo.pop());
-
-  m_previousIndex = m_stack.currentIndex();
-  */
-  commit();
+  append(Undo, {});
 }
 
 void CommandBackupFile::on_redo()
 {
-  /*
   // Pop from redoable to undoable
-  m_backup.savedUndo.push(m_savedRedo.pop());
+  append(Redo, {});
+}
 
-  m_previousIndex = m_stack.currentIndex();
-  */
-  commit();
+void CommandBackupFile::on_merge()
+{
+  // The command at the top of m_undoable changed
+  append(Merge, DataStream::Serializer::marshall(
+                    CommandData{*m_stack.undoable().top()}));
 }
 
 void CommandBackupFile::on_indexChanged()
 {
-  /*
-  // Pop a lot
-  auto index = m_stack.currentIndex();
-  if(index > m_previousIndex)
+  // Many commands may have been undone or redone at once
+  QByteArray payload;
   {
-      for(int i = 0; i < index - m_previousIndex; i++)
-      {
-          m_backup.savedUndo.push(m_savedRedo.pop());
-      }
+    QDataStream s{&payload, QIODevice::WriteOnly};
+    s.setVersion(QDataStream::Qt_5_7);
+    s << qint32(m_stack.currentIndex());
   }
-  else if(index < m_previousIndex)
+  append(Index, payload);
+}
+
+void CommandBackupFile::append(quint8 type, const QByteArray& payload)
+{
+  if (++m_records >= checkpointInterval)
   {
-      for(int i = 0; i < m_previousIndex - index ; i++)
-      {
-          m_backup.savedRedo.push(m_savedUndo.pop());
-      }
+    checkpoint();
+    return;
+  }
+
+  m_file.seek(m_file.size());
+  {
+    QDataStream s{&m_file};
+    s.setVersion(QDataStream::Qt_5_7);
+    s << type << payload;
   }
 
-  m_previousIndex = m_stack.currentIndex();
-  */
-  commit();
+  if (m_sync == ApplicationSettings::BackupSync::Always)
+    syncToDisk(m_file);
+  else
+    m_file.flush();
 }
 
-void CommandBackupFile::commit()
+void CommandBackupFile::checkpoint()
 {
-  // OPTIMIZEME: right now all the data is flushed each time.
-  // It should be better to only incrementally modify the file.
-  // See :
-  // http://www.boost.org/doc/libs/1_59_0/doc/html/interprocess/sharedmemorybetweenprocesses.html#interprocess.sharedmemorybetweenprocesses.mapped_file
-
-  // Another possibility would be to save the commands to a db ?
+  m_records = 0;
   m_file.resize(0);
   m_file.reset();
 
-  DataStream::Serializer ser(&m_file);
-  ser.readFrom(m_stack);
+  {
+    QDataStream s{&m_file};
+    s.setVersion(QDataStream::Qt_5_7);
+    s << journalMagic << quint8(Checkpoint)
+      << DataStream::Serializer::marshall(m_stack);
+  }
+
+  if (m_sync != ApplicationSettings::BackupSync::Never)
+    syncToDisk(m_file);
+  else
+    m_file.flush();
+}
+
+QByteArray CommandBackupFile::replay(QIODevice& journal)
+{
+  const QByteArray data = journal.readAll();
+
+  QDataStream s{data};
+  s.setVersion(QDataStream::Qt_5_7);
+
+  quint32 magic{};
+  s >> magic;
+  if (magic != journalMagic)
+    return data;
+
+  std::vector<CommandData> undoStack, redoStack;
+  while (!s.atEnd())
+  {
+    quint8 type{};
+    QByteArray payload;
+    s >> type >> payload;
+    if (s.status() != QDataStream::Ok)
+      break;
+
+    switch (type)
+    {
+      case Checkpoint:
+      {
+        undoStack.clear();
+        redoStack.clear();
+        DataStream::Deserializer writer{payload};
+        writer.writeTo(undoStack);
+        writer.writeTo(redoStack);
+        break;
+      }
+      case Push:
+      {
+        CommandData cmd;
+        DataStream::Deserializer writer{payload};
+        writer.writeTo(cmd);
+        undoStack.push_back(std::move(cmd));
+        redoStack.clear();
+        break;
+      }
+      case Merge:
+      {
+        if (undoStack.empty())
+          break;
+        DataStream::Deserializer writer{payload};
+        writer.writeTo(undoStack.back());
+        break;
+      }
+      case Undo:
+      {
+        if (undoStack.empty())
+          break;
+        redoStack.push_back(std::move(undoStack.back()));
+        undoStack.pop_back();
+        break;
+      }
+      case Redo:
+      {
+        if (redoStack.empty())
+          break;
+        undoStack.push_back(std::move(redoStack.back()));
+        redoStack.pop_back();
+        break;
+      }
+      case Index:
+      {
+        QDataStream index_stream{payload};
+        index_stream.setVersion(QDataStream::Qt_5_7);
+        qint32 index{};
+        index_stream >> index;
+
+        while (int(undoStack.size()) > index)
+        {
+          redoStack.push_back(std::move(undoStack.back()));
+          undoStack.pop_back();
+        }
+        while (int(undoStack.size()) < index && !redoStack.empty())
+        {
+          undoStack.push_back(std::move(redoStack.back()));
+          redoStack.pop_back();
+        }
+        break;
+      }
+    }
+  }
 
-  m_file.flush();
+  // Same format as DataStreamReader::read(const CommandStack&)
+  QByteArray res;
+  DataStream::Serializer ser{&res};
+  ser.readFrom(undoStack);
+  ser.readFrom(redoStack);
+  ser.insertDelimiter();
+  return res;
 }
 } // namespace score
@@ -2,32 +2,27 @@
 #include <score/command/Command.hpp>
 #include <score/command/CommandData.hpp>
 
+#include <core/application/ApplicationSettings.hpp>
+
 #include <QByteArray>
 #include <QObject>
-#include <QPair>
-#include <QStack>
 #include <QString>
 #include <QTemporaryFile>
 
+class QIODevice;
 namespace score
 {
 class CommandStack;
-/**
- * @brief Serialized command stack data for backup / restore
- */
-struct CommandStackBackup
-{
-  CommandStackBackup(const score::CommandStack& stack);
-
-  QStack<CommandData> savedUndo;
-  QStack<CommandData> savedRedo;
-};
 
 /**
  * @brief Abstraction over the backup of commands
  *
- * Synchronizes the commands of a document to an on-disk file,
- * by maintaining serialized stacks of commands at each new command.
+ * Synchronizes the commands of a document to an on-disk journal.
+ *
+ * The journal starts with a checkpoint, which contains the whole serialized
+ * command stack; a record is then appended for each push, merge, undo,
+ * redo and jump to another index. Every checkpointInterval records, the
+ * file is rewritten from a new checkpoint.
  *
  * This way, if there is a crash, the document can be restored from the
  * last successful command and only the latest user action is lost.
@@ -38,17 +33,32 @@ public:
   CommandBackupFile(const score::CommandStack& stack, QObject* parent);
   QString fileName() const;
 
+  /**
+   * @brief Reads a journal written by a CommandBackupFile.
+   *
+   * Replays the records written after the checkpoint, and returns the
+   * command stack in the format read by score::loadCommandStack.
+   * A partially written record at the end of the journal is ignored.
+   */
+  static QByteArray replay(QIODevice& journal);
+
+  static constexpr int checkpointInterval = 256;
+
 private:
   void on_push();
   void on_undo();
   void on_redo();
+  void on_merge();
   void on_indexChanged();
 
-  //! Writes the current buffers to disk.
-  void commit();
+  void append(quint8 type, const QByteArray& payload);
+
+  //! Rewrites the file with the current state of the stack.
+  void checkpoint();
 
   const score::CommandStack& m_stack;
-  CommandStackBackup m_backup;
+  ApplicationSettings::BackupSync m_sync{};
+  int m_records{};
 
   QTemporaryFile m_file;
 };
@@ -2,6 +2,8 @@
 
 #include <QString>
 
+#include <score_lib_base_export.h>
+
 namespace score
 {
 /**
@@ -11,7 +13,7 @@ namespace score
  * that are currently open,
  * and will be used to reload them in case of crash.
  */
-struct OpenDocumentsFile
+struct SCORE_LIB_BASE_EXPORT OpenDocumentsFile
 {
   static bool exists();
   static QString path();
@@ -1,21 +1,35 @@
 // This is an open source non-commercial project. Dear PVS-Studio, please check
 // it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include <score/application/ApplicationContext.hpp>
 #include <score/command/Command.hpp>
 #include <score/command/Validity/ValidityChecker.hpp>
 #include <score/document/DocumentContext.hpp>
 
+#include <core/application/ApplicationSettings.hpp>
 #include <core/command/CommandStack.hpp>
+#include <core/command/StoredCommand.hpp>
 #include <core/document/Document.hpp>
 
 #include <QVector>
 #include <QtAlgorithms>
 
+#include <algorithm>
+#include <limits>
+
 #include <wobjectimpl.h>
 W_OBJECT_IMPL(score::CommandStack)
 namespace score
 {
+namespace
+{
+//! Number of commands on each side of the current index which are kept
+//! instantiated, so that they can be undone and redone without delay.
+constexpr int liveCommands = 16;
+}
+
 CommandStack::CommandStack(const score::Document& ctx, QObject* parent)
-    : m_checker{score::AppComponents().interfaces<ValidityCheckerList>(), ctx}
+    : m_memoryBudget{score::AppContext().applicationSettings.undoMemoryBudget}
+    , m_checker{score::AppComponents().interfaces<ValidityCheckerList>(), ctx}
     , m_ctx{ctx.context()}
 {
   this->setObjectName("CommandStack");
@@ -24,8 +38,7 @@ CommandStack::CommandStack(const score::Document& ctx, QObject* parent)
 
 CommandStack::~CommandStack()
 {
-  qDeleteAll(m_undoable);
-  qDeleteAll(m_redoable);
+  clear();
 }
 
 void CommandStack::enableActions()
@@ -91,19 +104,133 @@ void CommandStack::markCurrentIndexAsSaved()
   setSavedIndex(currentIndex());
 }
 
+void CommandStack::markAsUnsaved()
+{
+  setSavedIndex(std::numeric_limits<int>::min());
+}
+
 bool CommandStack::isAtSavedIndex() const
 {
   return currentIndex() == m_savedIndex;
 }
 
-void CommandStack::setIndexQuiet(int index)
+void CommandStack::clear()
 {
-  while (index >= 0 && currentIndex() != index)
+  qDeleteAll(m_undoable);
+  qDeleteAll(m_redoable);
+  m_undoable.clear();
+  m_redoable.clear();
+
+  m_undoStored = {};
+  m_redoStored = {};
+  m_storedBytes = 0;
+}
+
+void CommandStack::setMemoryBudget(qint64 bytes)
+{
+  m_memoryBudget = bytes;
+  spillOverBudget();
+}
+
+void CommandStack::compactHistory()
+{
+  compactStack(m_undoable, m_undoStored);
+  compactStack(m_redoable, m_redoStored);
+  spillOverBudget();
+}
+
+void CommandStack::compactStack(
+    QStack<score::Command*>& stack,
+    StoredCommands& stored)
+{
+  const std::size_t far
+      = std::size_t(std::max(0, int(stack.size()) - liveCommands));
+
+  // Within an update, a stack only grows or shrinks, hence the commands
+  // below its smallest size did not move since the last call.
+
+  // Commands which came back close to the current index, or were removed.
+  // They are left stored: they are instantiated again when needed.
+  while (stored.costs.size() > far)
+  {
+    m_storedBytes -= stored.costs.back();
+    stored.costs.pop_back();
+  }
+  stored.spilled = std::min(stored.spilled, stored.costs.size());
+
+  // Commands which went far from the current index
+  for (std::size_t i = stored.costs.size(); i < far; i++)
   {
-    if (index < currentIndex())
-      undoQuiet();
+    auto& cmd = stack[int(i)];
+    auto st = dynamic_cast<StoredCommand*>(cmd);
+    if (st)
+    {
+      st->compress();
+    }
     else
-      redoQuiet();
+    {
+      st = new StoredCommand{cmd};
+      cmd = st;
+    }
+
+    stored.costs.push_back(st->memoryCost());
+    m_storedBytes += stored.costs.back();
+  }
+}
+
+void CommandStack::spillOverBudget()
+{
+  while (m_storedBytes > m_memoryBudget)
+  {
+    // The furthest command from the current index which is still in memory
+    const bool undo = m_undoStored.spilled < m_undoStored.costs.size();
+    const bool redo = m_redoStored.spilled < m_redoStored.costs.size();
+    if (!undo && !redo)
+      return;
+
+    const int undo_distance = m_undoable.size() - int(m_undoStored.spilled);
+    const int redo_distance = m_redoable.size() - int(m_redoStored.spilled);
+    const bool from_undo = undo && (!redo || undo_distance >= redo_distance);
+
+    auto& stack = from_undo ? m_undoable : m_redoable;
+    auto& stored = from_undo ? m_undoStored : m_redoStored;
+    auto& cmd = *static_cast<StoredCommand*>(stack[int(stored.spilled)]);
+
+    if (!m_spill)
+      m_spill = std::make_unique<CommandSpillFile>();
+    cmd.spill(*m_spill);
+    if (!cmd.isSpilled())
+      return;
+
+    auto& cost = stored.costs[stored.spilled];
+    m_storedBytes += cmd.memoryCost() - cost;
+    cost = cmd.memoryCost();
+    stored.spilled++;
+  }
+}
+
+void CommandStack::setIndexQuiet(int index)
+{
+  // All the commands are applied at once: the document is validated and
+  // the signals are sent only once, after the last one.
+  if (index >= 0 && index != currentIndex())
+  {
+    m_lastEdit.invalidate();
+    updateStack([&]() {
+      while (currentIndex() > index && canUndo())
+      {
+        auto cmd = m_undoable.pop();
+        cmd->undo(m_ctx);
+        m_redoable.push(cmd);
+      }
+
+      while (currentIndex() < index && canRedo())
+      {
+        auto cmd = m_redoable.pop();
+        cmd->redo(m_ctx);
+        m_undoable.push(cmd);
+      }
+    });
   }
 
   sig_indexChanged();
@@ -120,6 +247,7 @@ void CommandStack::setIndex(int index)
 
 void CommandStack::undoQuiet()
 {
+  m_lastEdit.invalidate();
   updateStack([&]() {
     auto cmd = m_undoable.pop();
     cmd->undo(m_ctx);
@@ -131,6 +259,7 @@ void CommandStack::undoQuiet()
 
 void CommandStack::redoQuiet()
 {
+  m_lastEdit.invalidate();
   updateStack([&]() {
     auto cmd = m_redoable.pop();
     cmd->redo(m_ctx);
@@ -157,6 +286,8 @@ void CommandStack::push(Command* cmd)
 
     // Push operation
     m_undoable.push(cmd);
+    m_lastEdit.start();
+    m_lastPush.start();
 
     if (!m_redoable.empty())
     {
@@ -183,6 +314,8 @@ void CommandStack::pushQuiet(Command* cmd)
 
     // Push operation
     m_undoable.push(cmd);
+    m_lastEdit.start();
+    m_lastPush.start();
 
     if (!m_redoable.empty())
     {
@@ -194,8 +327,34 @@ void CommandStack::pushQuiet(Command* cmd)
   });
 }
 
+void CommandStack::redoAndMerge(Command* cmd)
+{
+  cmd->redo(m_ctx);
+
+  // Merging in the saved state would make it unreachable
+  const bool can_merge = canUndo() && !canRedo()
+                         && currentIndex() != m_savedIndex
+                         && m_lastEdit.isValid()
+                         && !m_lastEdit.hasExpired(mergeDelay)
+                         && !m_lastPush.hasExpired(mergeWindow);
+
+  if (can_merge && m_undoable.top()->mergeWith(*cmd))
+  {
+    delete cmd;
+    updateStack([&]() {
+      m_lastEdit.start();
+      sig_merge();
+    });
+  }
+  else
+  {
+    push(cmd);
+  }
+}
+
 void CommandStack::setSavedIndex(int index)
 {
   m_savedIndex = index;
+  savedIndexChanged(index);
 }
 } // namespace score
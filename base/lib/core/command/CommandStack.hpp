@@ -2,15 +2,20 @@
 #include <score/command/Command.hpp>
 #include <score/command/Validity/ValidityChecker.hpp>
 
+#include <QElapsedTimer>
 #include <QObject>
 #include <QStack>
 #include <QString>
 
 #include <verdigris>
 
+#include <memory>
+#include <vector>
+
 namespace score
 {
 class Document;
+class CommandSpillFile;
 
 /**
  * \class score::CommandStack
@@ -21,14 +26,17 @@ class Document;
  * This class should never be used directly to send commands.
  * Instead, the various command dispatchers, in score/command/Dispatchers
  * should be used.
+ *
+ * The commands far from the current index are replaced by StoredCommand
+ * instances, which only keep them compressed; when their total size goes
+ * over the memory budget, the furthest ones are moved to a temporary file.
+ * This is done incrementally: only the commands which cross the limit of
+ * the commands kept instantiated are visited after a change of the stacks.
  */
 class SCORE_LIB_BASE_EXPORT CommandStack final : public QObject
 {
   W_OBJECT(CommandStack)
 
-  friend class CommandBackupFile;
-  friend struct CommandStackBackup;
-
 public:
   explicit CommandStack(const score::Document& ctx, QObject* parent = nullptr);
   ~CommandStack();
@@ -65,8 +73,19 @@ public:
 
   void markCurrentIndexAsSaved();
 
+  //! No index matches the saved document, not even the empty stack:
+  //! e.g. the document was loaded from a copy which is not its file.
+  void markAsUnsaved();
+
   bool isAtSavedIndex() const;
 
+  //! Deletes all the commands, without undoing them.
+  void clear();
+
+  //! Number of bytes the stored commands can use before going to the disk.
+  qint64 memoryBudget() const noexcept { return m_memoryBudget; }
+  void setMemoryBudget(qint64 bytes);
+
   QStack<score::Command*>& undoable() { return m_undoable; }
   QStack<score::Command*>& redoable() { return m_redoable; }
   const QStack<score::Command*>& undoable() const { return m_undoable; }
@@ -111,8 +130,20 @@ public:
               W_SIGNAL(sig_push) void sig_indexChanged()
                   W_SIGNAL(sig_indexChanged)
 
-                      void setIndex(int index);
+  //! Sent when a command was merged in the one at the top of the stack.
+  void sig_merge() W_SIGNAL(sig_merge)
+
+  //! Sent when the document is saved, and when the saved state is lost.
+  void savedIndexChanged(int index) W_SIGNAL(savedIndexChanged, index)
+
+  void setIndex(int index);
   W_INVOKABLE(setIndex)
+  /**
+   * @brief Undoes or redoes commands until reaching an index
+   *
+   * Only sends sig_indexChanged, not sig_undo and sig_redo for each
+   * command.
+   */
   void setIndexQuiet(int index);
   W_INVOKABLE(setIndexQuiet)
 
@@ -146,6 +177,18 @@ public:
    */
   void redoAndPushQuiet(score::Command* cmd);
   W_INVOKABLE(redoAndPushQuiet)
+
+  /**
+   * @brief Calls cmd::redo() and merges the command in the last one
+   * @param cmd The command
+   *
+   * The command is merged if the last one was pushed or merged less than
+   * mergeDelay ago, if the first of the merged commands was pushed less than
+   * mergeWindow ago, and if Command::mergeWith accepts it.
+   * Otherwise it is pushed.
+   */
+  void redoAndMerge(score::Command* cmd);
+  W_INVOKABLE(redoAndMerge)
   void pushQuiet(score::Command* cmd);
   W_INVOKABLE(pushQuiet)
 
@@ -180,6 +223,8 @@ public:
     c();
     m_checker();
 
+    compactHistory();
+
     if (pre_canUndo != canUndo())
       canUndoChanged(canUndo());
 
@@ -202,12 +247,44 @@ public:
 
   void setSavedIndex(int index);
 
+  static constexpr qint64 mergeDelay = 1000;
+  static constexpr qint64 mergeWindow = 5000;
+
 private:
+  //! The commands of a stack which are far from the current index:
+  //! positions [0, costs.size()) of the stack, from the furthest one.
+  struct StoredCommands
+  {
+    //! Memory cost of each command when it was stored.
+    std::vector<qint64> costs;
+    //! Number of commands, from the furthest one, moved to the disk.
+    std::size_t spilled{};
+  };
+
+  //! Compresses the commands which went far from the current index since
+  //! the last call, and spills the furthest ones to the disk when over the
+  //! memory budget.
+  void compactHistory();
+  void compactStack(QStack<score::Command*>& stack, StoredCommands& stored);
+  void spillOverBudget();
+
   QStack<score::Command*> m_undoable;
   QStack<score::Command*> m_redoable;
 
+  StoredCommands m_undoStored;
+  StoredCommands m_redoStored;
+  //! Sum of the costs of the stored commands
+  qint64 m_storedBytes{};
+
   int m_savedIndex{};
 
+  // Time since the last push or merge, and since the last push
+  QElapsedTimer m_lastEdit;
+  QElapsedTimer m_lastPush;
+
+  qint64 m_memoryBudget{};
+  std::unique_ptr<CommandSpillFile> m_spill;
+
   DocumentValidator m_checker;
   const score::DocumentContext& m_ctx;
 };
@@ -20,8 +20,7 @@ void loadCommandStack(
 
   writer.checkDelimiter();
 
-  stack.undoable().clear();
-  stack.redoable().clear();
+  stack.clear();
 
   stack.updateStack([&]() {
     stack.setSavedIndex(-1);
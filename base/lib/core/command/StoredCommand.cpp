@@ -0,0 +1,136 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "StoredCommand.hpp"
+
+#include <score/application/ApplicationComponents.hpp>
+#include <score/command/CommandData.hpp>
+#include <score/serialization/DataStreamVisitor.hpp>
+#include <score/tools/Todo.hpp>
+
+#include <QDir>
+
+namespace score
+{
+CommandSpillFile::CommandSpillFile()
+    : m_file{QDir::temp().filePath("segment-undo-XXXXXX")}
+{
+}
+
+CommandSpillFile::~CommandSpillFile() = default;
+
+qint64 CommandSpillFile::write(const QByteArray& data)
+{
+  if (!m_file.isOpen() && !m_file.open())
+    return -1;
+
+  const qint64 offset = m_file.size();
+  if (!m_file.seek(offset) || m_file.write(data) != data.size())
+    return -1;
+  return offset;
+}
+
+QByteArray CommandSpillFile::read(qint64 offset, qint64 size)
+{
+  if (!m_file.seek(offset))
+    return {};
+  return m_file.read(size);
+}
+
+StoredCommand::StoredCommand(score::Command* cmd)
+    : m_parentKey{cmd->parentKey()}
+    , m_key{cmd->key()}
+    , m_description{cmd->description()}
+{
+  const auto data = cmd->serialize();
+  m_commandCost = data.size();
+  m_compressed = qCompress(data);
+  delete cmd;
+}
+
+StoredCommand::~StoredCommand() = default;
+
+void StoredCommand::undo(const score::DocumentContext& ctx) const
+{
+  command().undo(ctx);
+}
+
+void StoredCommand::redo(const score::DocumentContext& ctx) const
+{
+  command().redo(ctx);
+}
+
+const CommandGroupKey& StoredCommand::parentKey() const noexcept
+{
+  return m_parentKey;
+}
+
+const CommandKey& StoredCommand::key() const noexcept
+{
+  return m_key;
+}
+
+QString StoredCommand::description() const
+{
+  return m_description;
+}
+
+qint64 StoredCommand::memoryCost() const noexcept
+{
+  // The serialized size is used as an estimate of the size of a command.
+  qint64 cost = m_compressed.size();
+  if (m_command)
+    cost += m_commandCost;
+  return cost;
+}
+
+void StoredCommand::compress()
+{
+  m_command.reset();
+}
+
+void StoredCommand::spill(CommandSpillFile& file)
+{
+  if (m_file)
+    return;
+
+  const auto offset = file.write(m_compressed);
+  if (offset < 0)
+    return;
+
+  m_file = &file;
+  m_offset = offset;
+  m_size = m_compressed.size();
+  m_compressed = QByteArray{};
+}
+
+QByteArray StoredCommand::compressedData() const
+{
+  return m_file ? m_file->read(m_offset, m_size) : m_compressed;
+}
+
+score::Command& StoredCommand::command() const
+{
+  if (!m_command)
+  {
+    CommandData data;
+    data.parentKey = m_parentKey;
+    data.commandKey = m_key;
+    data.data = qUncompress(compressedData());
+    m_command.reset(score::AppComponents().instantiateUndoCommand(data));
+  }
+  return *m_command;
+}
+
+void StoredCommand::serializeImpl(DataStreamInput& s) const
+{
+  const auto data = qUncompress(compressedData());
+  s.stream.writeRawData(data.constData(), data.size());
+}
+
+void StoredCommand::deserializeImpl(DataStreamOutput&)
+{
+  // Stored commands are never created from serialized data:
+  // the wrapped command is.
+  SCORE_ABORT;
+}
+} // namespace score
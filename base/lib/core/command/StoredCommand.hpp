@@ -0,0 +1,89 @@
+#pragma once
+#include <score/command/Command.hpp>
+
+#include <QByteArray>
+#include <QString>
+#include <QTemporaryFile>
+
+#include <memory>
+
+namespace score
+{
+/**
+ * @brief Append-only temporary file in which the oldest commands of an
+ * undo history are kept.
+ *
+ * Removed when the history is destroyed.
+ */
+class CommandSpillFile
+{
+public:
+  CommandSpillFile();
+  ~CommandSpillFile();
+
+  //! Returns the offset at which the data was written, or -1 on failure.
+  qint64 write(const QByteArray& data);
+  QByteArray read(qint64 offset, qint64 size);
+
+private:
+  QTemporaryFile m_file;
+};
+
+/**
+ * @brief Stands for a command of the undo history which is far from the
+ * current index.
+ *
+ * The wrapped command is only kept in its serialized form, compressed, in
+ * memory or in a CommandSpillFile. It is instantiated again when undone or
+ * redone, and dropped on the next call to compress.
+ *
+ * It is serialized exactly like the wrapped command, hence saving or
+ * sending the command stack does not see the difference.
+ */
+class StoredCommand final : public score::Command
+{
+public:
+  //! Takes ownership of the command.
+  explicit StoredCommand(score::Command* cmd);
+  ~StoredCommand() override;
+
+  void undo(const score::DocumentContext& ctx) const override;
+  void redo(const score::DocumentContext& ctx) const override;
+
+  const CommandGroupKey& parentKey() const noexcept override;
+  const CommandKey& key() const noexcept override;
+  QString description() const override;
+
+  //! Approximate number of bytes kept in memory for the command.
+  qint64 memoryCost() const noexcept;
+
+  bool isSpilled() const noexcept { return m_file; }
+
+  //! Only keeps the compressed data of the command.
+  void compress();
+
+  //! Moves the compressed data to the file. Does nothing if it fails.
+  void spill(CommandSpillFile& file);
+
+protected:
+  void serializeImpl(DataStreamInput& s) const override;
+  void deserializeImpl(DataStreamOutput& s) override;
+
+private:
+  QByteArray compressedData() const;
+  score::Command& command() const;
+
+  mutable std::unique_ptr<score::Command> m_command;
+  qint64 m_commandCost{};
+
+  CommandGroupKey m_parentKey;
+  CommandKey m_key;
+  QString m_description;
+
+  QByteArray m_compressed;
+
+  CommandSpillFile* m_file{};
+  qint64 m_offset{};
+  qint64 m_size{};
+};
+} // namespace score
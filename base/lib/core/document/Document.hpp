@@ -8,6 +8,7 @@
 #include <core/document/DocumentMetadata.hpp>
 
 #include <QByteArray>
+#include <QJsonDocument>
 #include <QJsonObject>
 #include <QString>
 #include <QTimer>
@@ -15,6 +16,7 @@
 
 #include <verdigris>
 
+class QIODevice;
 class QObject;
 class QWidget;
 namespace score
@@ -79,6 +81,18 @@ public:
   QJsonObject saveAsJson();
   QByteArray saveAsByteArray();
 
+  //! Writes the same text as QJsonDocument{saveAsJson()}.toJson(format),
+  //! without keeping the whole document in memory.
+  //! Returns false if the device could not be written to.
+  bool saveAsJson(
+      QIODevice& device,
+      QJsonDocument::JsonFormat format = QJsonDocument::Indented);
+
+  //! Writes the same document as a BinaryDocument, in which the model
+  //! can store its large arrays as sections.
+  //! Returns false if the device could not be written to.
+  bool saveAsBinary(QIODevice& device);
+
   DocumentBackupManager* backupManager() const { return m_backupMgr; }
 
   void setBackupMgr(DocumentBackupManager* backupMgr);
@@ -114,6 +128,7 @@ private:
       QObject* parent);
 
   void init();
+  QJsonObject savePluginModelsAsJson();
 
   DocumentMetadata m_metadata;
   CommandStack m_commandStack;
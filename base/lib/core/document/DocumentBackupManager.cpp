@@ -9,20 +9,65 @@
 
 #include <QFile>
 #include <QMap>
+#include <QRunnable>
 #include <QSettings>
 #include <QStringList>
 #include <QVariant>
 
+#include <utility>
+
+#include <wobjectimpl.h>
+
+namespace score
+{
+/**
+ * @brief Writes the model data to the file, from a worker thread.
+ */
+class ModelDataWriter final : public QObject, public QRunnable
+{
+  W_OBJECT(ModelDataWriter)
+public:
+  ModelDataWriter(QString path, QByteArray data)
+      : m_path{std::move(path)}, m_data{std::move(data)}
+  {
+    setAutoDelete(false);
+    // Queued: the writer lives in the GUI thread.
+    connect(this, &ModelDataWriter::finished, this, &QObject::deleteLater);
+  }
+
+  void run() override
+  {
+    // The temporary file stays open in the GUI thread; it is written
+    // through another handle.
+    QFile f{m_path};
+    const bool ok = f.open(QIODevice::WriteOnly | QIODevice::Truncate)
+                    && f.write(m_data) == m_data.size() && f.flush();
+    finished(ok);
+  }
+
+  //! Sent from the worker thread.
+  void finished(bool ok) W_SIGNAL(finished, ok);
+
+private:
+  QString m_path;
+  QByteArray m_data;
+};
+}
+
 score::DocumentBackupManager::DocumentBackupManager(score::Document& doc)
     : QObject{&doc}, m_doc{doc}
 {
   m_modelFile.open();
 
   m_commandFile = new CommandBackupFile{doc.commandStack(), this};
+
+  m_writer.setMaxThreadCount(1);
 }
 
 score::DocumentBackupManager::~DocumentBackupManager()
 {
+  m_writer.waitForDone();
+
 #if !defined(__EMSCRIPTEN__)
   QSettings s(OpenDocumentsFile::path(), QSettings::IniFormat);
   auto existing_files = s.value("score/docs").toStringList();
@@ -36,10 +81,24 @@ score::DocumentBackupManager::~DocumentBackupManager()
 
 void score::DocumentBackupManager::saveModelData(const QByteArray& arr)
 {
-  m_modelFile.resize(0);
-  m_modelFile.reset();
-  m_modelFile.write(arr);
-  m_modelFile.flush();
+  if (m_writing)
+  {
+    // Replaces the data which was waiting for the write in progress
+    m_pendingData = arr;
+    return;
+  }
+
+  m_writing = true;
+  auto writer = new ModelDataWriter{m_modelFile.fileName(), arr};
+  connect(writer, &ModelDataWriter::finished, this, [this](bool ok) {
+    m_writing = false;
+    if (ok)
+      updateBackupData();
+
+    if (!m_pendingData.isNull())
+      saveModelData(std::exchange(m_pendingData, QByteArray{}));
+  });
+  m_writer.start(writer);
 }
 
 QTemporaryFile& score::DocumentBackupManager::crashDataFile()
@@ -66,3 +125,5 @@ void score::DocumentBackupManager::updateBackupData()
   s.setValue("score/docs", existing_files);
 #endif
 }
+
+W_OBJECT_IMPL(score::ModelDataWriter)
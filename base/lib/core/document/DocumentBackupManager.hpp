@@ -2,6 +2,7 @@
 #include <QByteArray>
 #include <QObject>
 #include <QTemporaryFile>
+#include <QThreadPool>
 
 namespace score
 {
@@ -38,6 +39,14 @@ public:
 
   ~DocumentBackupManager();
 
+  /**
+   * @brief Replaces the saved state of the document.
+   *
+   * The data is written in the background. Only the latest data waits for
+   * the write in progress, if any: older data which was not written yet
+   * is dropped. The document is registered for restoring once the data is
+   * written.
+   */
   void saveModelData(const QByteArray&);
 
   void updateBackupData();
@@ -49,5 +58,10 @@ private:
   score::Document& m_doc;
   QTemporaryFile m_modelFile;
   CommandBackupFile* m_commandFile{};
+
+  //! Writes the model data, one write at a time.
+  QThreadPool m_writer;
+  QByteArray m_pendingData;
+  bool m_writing{};
 };
 } // namespace score
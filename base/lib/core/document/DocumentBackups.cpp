@@ -4,6 +4,7 @@
 
 #include <score/tools/QMapHelper.hpp>
 
+#include <core/application/CommandBackupFile.hpp>
 #include <core/application/OpenDocumentsFile.hpp>
 
 #include <QApplication>
@@ -55,8 +56,9 @@ static void loadRestorableDocumentData(
     data_file.open(QFile::ReadOnly);
     command_file.open(QFile::ReadOnly);
 
-    arr.push_back(
-        {command_filename.first, data_file.readAll(), command_file.readAll()});
+    arr.push_back({command_filename.first,
+                   data_file.readAll(),
+                   CommandBackupFile::replay(command_file)});
 
     data_file.close();
     data_file.remove(); // Note: maybe we don't want to remove them that early?
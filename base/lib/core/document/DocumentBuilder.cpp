@@ -174,7 +174,7 @@ Document* DocumentBuilder::restoreDocument(
 
 void DocumentBuilder::setBackupManager(Document* doc)
 {
-  m_backupManager->updateBackupData();
+  // The document is registered for restoring once its data is written
   doc->setBackupMgr(m_backupManager);
   m_backupManager = nullptr;
 }
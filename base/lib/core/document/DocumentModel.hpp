@@ -57,6 +57,14 @@ public:
                     score::DocumentContext& ctx,
                     const QJsonObject&,
                     DocumentDelegateFactory& fact);
+  void loadDocumentAsJsonText(
+      score::DocumentContext& ctx,
+      const QByteArray&,
+      DocumentDelegateFactory& fact);
+  void loadDocumentAsBinary(
+      score::DocumentContext& ctx,
+      const QByteArray&,
+      DocumentDelegateFactory& fact);
   void loadDocumentAsByteArray(
       score::DocumentContext& ctx,
       const QByteArray&,
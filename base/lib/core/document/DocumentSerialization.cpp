@@ -12,7 +12,10 @@
 #include <score/plugins/documentdelegate/DocumentDelegateFactory.hpp>
 #include <score/plugins/documentdelegate/DocumentDelegateModel.hpp>
 #include <score/plugins/documentdelegate/plugin/DocumentPlugin.hpp>
+#include <score/serialization/BinaryDocument.hpp>
 #include <score/serialization/DataStreamVisitor.hpp>
+#include <score/serialization/JSONStreamReader.hpp>
+#include <score/serialization/JSONStreamWriter.hpp>
 #include <score/serialization/JSONValueVisitor.hpp>
 #include <score/serialization/JSONVisitor.hpp>
 #include <score/tools/IdentifierGeneration.hpp>
@@ -66,10 +69,9 @@ QJsonObject Document::saveDocumentModelAsJson()
   return s.obj;
 }
 
-QJsonObject Document::saveAsJson()
+QJsonObject Document::savePluginModelsAsJson()
 {
-  using namespace std;
-  QJsonObject complete, json_plugins;
+  QJsonObject json_plugins;
 
   for (const auto& plugin : model().pluginModels())
   {
@@ -88,7 +90,15 @@ QJsonObject Document::saveAsJson()
     }
   }
 
-  complete["Plugins"] = json_plugins;
+  return json_plugins;
+}
+
+QJsonObject Document::saveAsJson()
+{
+  using namespace std;
+  QJsonObject complete;
+
+  complete["Plugins"] = savePluginModelsAsJson();
   complete["Document"] = saveDocumentModelAsJson();
   complete["Version"]
       = context().app.applicationSettings.saveFormatVersion.value();
@@ -98,6 +108,48 @@ QJsonObject Document::saveAsJson()
   return complete;
 }
 
+bool Document::saveAsJson(QIODevice& device, QJsonDocument::JsonFormat format)
+{
+  JSONStreamWriter writer{device, format};
+
+  // Same members as saveAsJson(), in the same order
+  writer.beginObject();
+  writer.key("Document");
+  m_model->modelDelegate().serializeJson(writer);
+  writer.key("Plugins");
+  writer.value(savePluginModelsAsJson());
+  writer.key("Version");
+  writer.value(context().app.applicationSettings.saveFormatVersion.value());
+  writer.endObject();
+
+  if (!writer.ok())
+    return false;
+
+  // Indicate in the stack that the current position is saved
+  m_commandStack.markCurrentIndexAsSaved();
+  return true;
+}
+
+bool Document::saveAsBinary(QIODevice& device)
+{
+  BinaryDocumentWriter writer;
+
+  QJsonObject complete;
+  complete["Document"]
+      = m_model->modelDelegate().serializeBinary(writer, "Document");
+  complete["Plugins"] = savePluginModelsAsJson();
+  complete["Version"]
+      = context().app.applicationSettings.saveFormatVersion.value();
+  writer.setHeader(complete);
+
+  if (!writer.write(device))
+    return false;
+
+  // Indicate in the stack that the current position is saved
+  m_commandStack.markCurrentIndexAsSaved();
+  return true;
+}
+
 QByteArray Document::saveAsByteArray()
 {
   using namespace std;
@@ -273,26 +325,30 @@ void DocumentModel::loadDocumentAsByteArray(
   }
 }
 
-void DocumentModel::loadDocumentAsJson(
+namespace
+{
+/**
+ * Loads the plug-in models first, then the model with loadModel,
+ * then the parts of the plug-ins which depend on the model.
+ *
+ * This *has* to be in this order, because the plugin models might put
+ * some data in the document that requires the plugin models to be loaded
+ * in order to be deserialized.
+ */
+template <typename LoadModel>
+void loadJsonModels(
+    DocumentModel& model,
     score::DocumentContext& ctx,
-    const QJsonObject& json,
-    DocumentDelegateFactory& fact)
+    const QJsonObject& json_plugins,
+    LoadModel loadModel)
 {
-  const auto& doc_obj = json.find("Document");
-  if (doc_obj == json.end())
-    throw std::runtime_error(tr("Invalid document").toStdString());
-
-  const auto& doc = (*doc_obj).toObject();
-  this->setId(getStrongId(ctx.app.documents.documents()));
-
   score::hash_map<score::SerializableDocumentPlugin*, QJsonObject> docs;
   // Load the plug-in models
-  auto json_plugins = json["Plugins"].toObject();
   auto& plugin_factories = ctx.app.interfaces<DocumentPluginFactoryList>();
   Foreach(json_plugins.keys(), [&](const auto& key) {
     JSONObject::Deserializer plug_writer{json_plugins[key].toObject()};
     auto plug
-        = deserialize_interface(plugin_factories, plug_writer, ctx, this);
+        = deserialize_interface(plugin_factories, plug_writer, ctx, &model);
 
     if (plug)
     {
@@ -304,7 +360,7 @@ void DocumentModel::loadDocumentAsJson(
           docs.insert({ser, it->toObject()});
         }
       }
-      this->addPluginModel(plug);
+      model.addPluginModel(plug);
     }
     else
     {
@@ -313,8 +369,7 @@ void DocumentModel::loadDocumentAsJson(
   });
 
   // Load the model
-  JSONObject::Deserializer doc_writer{doc};
-  fact.load(doc_writer.toVariant(), ctx, m_model, this);
+  loadModel();
 
   auto it_end = docs.end();
   for (auto it = docs.begin(); it != it_end; ++it)
@@ -324,6 +379,94 @@ void DocumentModel::loadDocumentAsJson(
   }
 }
 
+//! The binary saves start with the size of their first part,
+//! which cannot be the '{' character.
+bool isJsonText(const QByteArray& data)
+{
+  for (char c : data)
+  {
+    if (c != ' ' && c != '\n' && c != '\r' && c != '\t')
+      return c == '{';
+  }
+  return false;
+}
+} // namespace
+
+void DocumentModel::loadDocumentAsJson(
+    score::DocumentContext& ctx,
+    const QJsonObject& json,
+    DocumentDelegateFactory& fact)
+{
+  const auto& doc_obj = json.find("Document");
+  if (doc_obj == json.end())
+    throw std::runtime_error(tr("Invalid document").toStdString());
+
+  const auto& doc = (*doc_obj).toObject();
+  this->setId(getStrongId(ctx.app.documents.documents()));
+
+  loadJsonModels(*this, ctx, json["Plugins"].toObject(), [&] {
+    JSONObject::Deserializer doc_writer{doc};
+    fact.load(doc_writer.toVariant(), ctx, m_model, this);
+  });
+}
+
+void DocumentModel::loadDocumentAsJsonText(
+    score::DocumentContext& ctx,
+    const QByteArray& text,
+    DocumentDelegateFactory& fact)
+{
+  // The members are sorted in the file, hence the document comes before
+  // the plug-ins which have to be loaded first: it is only located here,
+  // and parsed afterwards.
+  JSONStreamReader reader{text};
+  QByteArray doc;
+  QJsonObject json_plugins;
+
+  if (reader.next() == JSONStreamReader::BeginObject)
+  {
+    while (reader.hasNext())
+    {
+      reader.next();
+      if (reader.key() == "Document")
+        doc = reader.rawValue();
+      else if (reader.key() == "Plugins")
+        json_plugins = reader.readValue().toObject();
+      else
+        reader.skipValue();
+    }
+  }
+
+  if (reader.hasError())
+    throw std::runtime_error(reader.errorString().toStdString());
+  if (doc.isEmpty())
+    throw std::runtime_error(tr("Invalid document").toStdString());
+
+  this->setId(getStrongId(ctx.app.documents.documents()));
+
+  loadJsonModels(*this, ctx, json_plugins, [&] {
+    JSONStreamReader doc_reader{doc};
+    fact.loadJson(doc_reader, ctx, m_model, this);
+  });
+}
+
+void DocumentModel::loadDocumentAsBinary(
+    score::DocumentContext& ctx,
+    const QByteArray& data,
+    DocumentDelegateFactory& fact)
+{
+  BinaryDocumentReader reader;
+  if (!reader.open(data))
+    throw std::runtime_error(reader.errorString().toStdString());
+  if (!reader.header()["Document"].isObject())
+    throw std::runtime_error(tr("Invalid document").toStdString());
+
+  this->setId(getStrongId(ctx.app.documents.documents()));
+
+  loadJsonModels(*this, ctx, reader.header()["Plugins"].toObject(), [&] {
+    fact.loadBinary(reader, "Document", ctx, m_model, this);
+  });
+}
+
 // Load document model
 DocumentModel::DocumentModel(
     score::DocumentContext& ctx,
@@ -345,7 +488,13 @@ DocumentModel::DocumentModel(
   {
     if (data.canConvert(QMetaType::QByteArray))
     {
-      loadDocumentAsByteArray(ctx, data.toByteArray(), fact);
+      const auto arr = data.toByteArray();
+      if (isJsonText(arr))
+        loadDocumentAsJsonText(ctx, arr, fact);
+      else if (BinaryDocumentReader::isBinaryDocument(arr))
+        loadDocumentAsBinary(ctx, arr, fact);
+      else
+        loadDocumentAsByteArray(ctx, arr, fact);
     }
     else if (data.canConvert(QMetaType::QJsonObject))
     {
@@ -10,6 +10,8 @@
 #include <score/plugins/documentdelegate/plugin/DocumentPlugin.hpp>
 #include <score/plugins/panel/PanelDelegate.hpp>
 #include <score/plugins/qt_interfaces/PluginRequirements_QtInterface.hpp>
+#include <score/serialization/BinaryDocument.hpp>
+#include <score/serialization/JSONStreamReader.hpp>
 #include <score/tools/IdentifierGeneration.hpp>
 #include <score/tools/std/Optional.hpp>
 
@@ -270,6 +272,20 @@ void DocumentManager::forceCloseDocument(
   delete &doc;
 }
 
+static QJsonDocument::JsonFormat jsonSaveFormat(const Document& doc)
+{
+  return doc.context().app.applicationSettings.compactJson
+             ? QJsonDocument::Compact
+             : QJsonDocument::Indented;
+}
+
+static bool isBinaryDocumentFile(const QString& path)
+{
+  QFile f{path};
+  return f.open(QIODevice::ReadOnly)
+         && BinaryDocumentReader::isBinaryDocument(f.read(8));
+}
+
 bool DocumentManager::saveDocument(Document& doc)
 {
   auto savename = doc.metadata().fileName();
@@ -281,17 +297,17 @@ bool DocumentManager::saveDocument(Document& doc)
   }
   else if (savename.size() != 0)
   {
+    // The binary documents stay binary
+    const bool binary = isBinaryDocumentFile(savename);
+
     QSaveFile f{savename};
     f.open(QIODevice::WriteOnly);
     if (savename.indexOf(".scorebin") != -1)
       f.write(doc.saveAsByteArray());
+    else if (binary)
+      doc.saveAsBinary(f);
     else
-    {
-      QJsonDocument json_doc;
-      json_doc.setObject(doc.saveAsJson());
-
-      f.write(json_doc.toJson());
-    }
+      doc.saveAsJson(f, jsonSaveFormat(doc));
     f.commit();
 
     m_recentFiles->addRecentFile(savename);
@@ -307,8 +323,9 @@ bool DocumentManager::saveDocumentAs(Document& doc)
     return false;
   QFileDialog d{m_view, tr("Save Document As")};
   QString jsonFilter{tr("SEGMent (*.segment)")};
+  QString binaryFilter{tr("SEGMent, binary (*.segment)")};
   QStringList filters;
-  filters << jsonFilter;
+  filters << jsonFilter << binaryFilter;
 
   d.setNameFilters(filters);
   d.setConfirmOverwrite(true);
@@ -328,11 +345,10 @@ bool DocumentManager::saveDocumentAs(Document& doc)
       QSaveFile f{savename};
       f.open(QIODevice::WriteOnly);
 
-      QJsonDocument json_doc;
-      json_doc.setObject(doc.saveAsJson());
-
-      f.write(json_doc.toJson());
-
+      if (suf == binaryFilter)
+        doc.saveAsBinary(f);
+      else
+        doc.saveAsJson(f, jsonSaveFormat(doc));
       f.commit();
 
       doc.model().modelDelegate().savedDocumentAs(doc.metadata().fileName(), savename);
@@ -448,7 +464,8 @@ Document* DocumentManager::loadFile(const score::GUIApplicationContext& ctx)
 
 Document* DocumentManager::loadFile(
     const score::GUIApplicationContext& ctx,
-    const QString& fileName)
+    const QString& fileName,
+    bool addToRecentFiles)
 {
   Document* doc{};
   if (!fileName.isEmpty() && (fileName.indexOf(".segment") != 1))
@@ -456,20 +473,59 @@ Document* DocumentManager::loadFile(
     QFile f{fileName};
     if (f.open(QIODevice::ReadOnly))
     {
-      if (m_recentFiles)
+      if (m_recentFiles && addToRecentFiles)
       {
         m_recentFiles->addRecentFile(fileName);
         saveRecentFilesState();
       }
 
-      auto json = QJsonDocument::fromJson(f.readAll());
-      bool ok = checkAndUpdateJson(json, ctx);
+      // The binary documents are mapped instead of being read:
+      // only the parts which are loaded are actually read from the disk.
+      // The mapping lasts until f is destroyed, after the loading.
+      QByteArray data;
+      if (BinaryDocumentReader::isBinaryDocument(f.peek(8)))
+      {
+        if (auto map = f.map(0, f.size()))
+        {
+          data = QByteArray::fromRawData(
+              reinterpret_cast<const char*>(map), int(f.size()));
+        }
+      }
+      if (data.isNull())
+        data = f.readAll();
+
+      // Documents in the current format are loaded while being parsed,
+      // the older ones are updated as a whole beforehand.
+      QVariant docData = data;
+      bool ok = true;
+      if (BinaryDocumentReader::isBinaryDocument(data))
+      {
+        // An invalid document is reported when loading it
+        BinaryDocumentReader reader;
+        if (reader.open(data)
+            && !isCurrentFormat(
+                   Version{reader.header()["Version"].toInt()},
+                   reader.header()["Plugins"].toObject(),
+                   ctx))
+        {
+          QJsonDocument json{reader.toJson()};
+          ok = checkAndUpdateJson(json, ctx);
+          docData = json.object();
+        }
+      }
+      else if (!isCurrentJsonFormat(data, ctx))
+      {
+        auto json = QJsonDocument::fromJson(data);
+        ok = checkAndUpdateJson(json, ctx);
+        docData = json.object();
+      }
+
       if (true || ok)
       {
         doc = loadDocument(
             ctx,
             fileName,
-            json.object(),
+            docData,
             *ctx.interfaces<DocumentDelegateList>().begin());
       }
       else
@@ -610,6 +666,68 @@ bool DocumentManager::checkAndUpdateJson(
   return mainLoadable && pluginsAvailable && pluginsLoadable;
 }
 
+bool DocumentManager::isCurrentJsonFormat(
+    const QByteArray& data,
+    const score::GUIApplicationContext& ctx)
+{
+  // Only the version and the plug-ins are read, the document is skipped.
+  JSONStreamReader reader{data};
+  if (reader.next() != JSONStreamReader::BeginObject)
+    return false;
+
+  Version loaded_version{0};
+  QJsonObject plugins;
+  while (reader.hasNext())
+  {
+    reader.next();
+    if (reader.key() == "Version")
+      loaded_version = Version{reader.readValue().toInt()};
+    else if (reader.key() == "Plugins")
+      plugins = reader.readValue().toObject();
+    else
+      reader.skipValue();
+  }
+
+  if (reader.hasError())
+    return false;
+
+  return isCurrentFormat(loaded_version, plugins, ctx);
+}
+
+bool DocumentManager::isCurrentFormat(
+    Version loaded_version,
+    const QJsonObject& plugins,
+    const score::GUIApplicationContext& ctx)
+{
+  if (loaded_version != ctx.applicationSettings.saveFormatVersion)
+    return false;
+
+  LocalPluginVersionsMap local_plugins;
+  for (const auto& plug : ctx.addons())
+  {
+    local_plugins.insert(plug.plugin);
+  }
+
+  auto& local_map = local_plugins.get<0>();
+  for (const auto& plugin_val : plugins)
+  {
+    const auto& plugin_obj = plugin_val.toObject();
+    auto plugin_key_it = plugin_obj.find("Key");
+    if (plugin_key_it == plugin_obj.end())
+      continue;
+
+    auto it = local_map.find(
+        UuidKey<score::Plugin>::fromString((*plugin_key_it).toString()));
+    if (it == local_map.end())
+      continue;
+
+    if (Version{plugin_obj["Version"].toInt()} != (*it)->version())
+      return false;
+  }
+
+  return true;
+}
+
 bool DocumentManager::updateJson(
     QJsonObject& object,
     Version json_ver,
@@ -109,8 +109,12 @@ public:
   Document* loadStack(const score::GUIApplicationContext& ctx, const QString&);
 
   Document* loadFile(const score::GUIApplicationContext& ctx);
-  Document*
-  loadFile(const score::GUIApplicationContext& ctx, const QString& filename);
+  //! The file is added to the recent files unless addToRecentFiles is false,
+  //! e.g. for a temporary copy of a document.
+  Document* loadFile(
+      const score::GUIApplicationContext& ctx,
+      const QString& filename,
+      bool addToRecentFiles = true);
 
   bool closeAllDocuments(const score::GUIApplicationContext& ctx);
 
@@ -130,6 +134,22 @@ private:
   bool
   checkAndUpdateJson(QJsonDocument&, const score::GUIApplicationContext& ctx);
 
+  /**
+   * @brief isCurrentJsonFormat
+   * @return true if the document and its plug-ins do not need any update,
+   * hence the file can be loaded while being parsed.
+   */
+  bool isCurrentJsonFormat(
+      const QByteArray& data,
+      const score::GUIApplicationContext& ctx);
+
+  //! Same as isCurrentJsonFormat, from the version and the plug-ins
+  //! members of a save file.
+  bool isCurrentFormat(
+      score::Version loaded_version,
+      const QJsonObject& plugins,
+      const score::GUIApplicationContext& ctx);
+
   bool updateJson(
       QJsonObject& object,
       score::Version json_ver,
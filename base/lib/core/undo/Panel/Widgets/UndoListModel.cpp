@@ -0,0 +1,85 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "UndoListModel.hpp"
+
+#include <score/command/Command.hpp>
+#include <score/tools/Todo.hpp>
+
+#include <core/command/CommandStack.hpp>
+
+#include <wobjectimpl.h>
+W_OBJECT_IMPL(score::UndoListModel)
+namespace score
+{
+UndoListModel::UndoListModel(score::CommandStack& s, QObject* parent)
+    : QAbstractListModel{parent}, m_stack{s}, m_commands{s.size()}
+{
+  con(m_stack,
+      &score::CommandStack::sig_push,
+      this,
+      &score::UndoListModel::on_push);
+  con(m_stack,
+      &score::CommandStack::sig_merge,
+      this,
+      &score::UndoListModel::on_merge);
+  con(m_stack,
+      &score::CommandStack::stackChanged,
+      this,
+      &score::UndoListModel::on_stackChanged);
+}
+
+UndoListModel::~UndoListModel() = default;
+
+int UndoListModel::rowCount(const QModelIndex& parent) const
+{
+  if (parent.isValid())
+    return 0;
+  return m_commands + 1;
+}
+
+QVariant UndoListModel::data(const QModelIndex& index, int role) const
+{
+  if (role != Qt::DisplayRole || !index.isValid())
+    return {};
+
+  if (index.row() == 0)
+    return QStringLiteral("<Clean state>");
+
+  if (auto cmd = m_stack.command(index.row() - 1))
+    return cmd->description();
+  return {};
+}
+
+void UndoListModel::on_push()
+{
+  // The commands that could be redone were removed,
+  // and the new one is the last of the stack.
+  const int pushed = m_stack.size() - 1;
+  if (m_commands > pushed)
+  {
+    beginRemoveRows({}, pushed + 1, m_commands);
+    m_commands = pushed;
+    endRemoveRows();
+  }
+
+  beginInsertRows({}, m_commands + 1, pushed + 1);
+  m_commands = pushed + 1;
+  endInsertRows();
+}
+
+void UndoListModel::on_merge()
+{
+  const auto idx = index(m_stack.currentIndex());
+  dataChanged(idx, idx, {Qt::DisplayRole});
+}
+
+void UndoListModel::on_stackChanged()
+{
+  if (m_commands != m_stack.size())
+  {
+    beginResetModel();
+    m_commands = m_stack.size();
+    endResetModel();
+  }
+}
+} // namespace score
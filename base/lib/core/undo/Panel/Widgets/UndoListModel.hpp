@@ -0,0 +1,40 @@
+#pragma once
+
+#include <QAbstractListModel>
+
+#include <verdigris>
+
+namespace score
+{
+class CommandStack;
+
+/**
+ * @brief List model of the commands of a CommandStack
+ *
+ * The first row is the state before the first command; row i + 1 is
+ * command i.
+ *
+ * Only the number of rows is cached: the descriptions are asked to the
+ * commands when the view displays them. Pushes and merges are reported
+ * as row insertions, removals and changes; other changes of the stack
+ * size, e.g. when a stack is loaded, reset the model.
+ */
+class UndoListModel final : public QAbstractListModel
+{
+  W_OBJECT(UndoListModel)
+public:
+  explicit UndoListModel(score::CommandStack& s, QObject* parent = nullptr);
+  ~UndoListModel() override;
+
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex& index, int role) const override;
+
+private:
+  void on_push();
+  void on_merge();
+  void on_stackChanged();
+
+  score::CommandStack& m_stack;
+  int m_commands{};
+};
+} // namespace score
@@ -7,13 +7,19 @@
 #include <core/command/CommandStack.hpp>
 
 #include <QItemSelectionModel>
+#include <QSignalBlocker>
 
 #include <wobjectimpl.h>
 W_OBJECT_IMPL(score::UndoListWidget)
 namespace score
 {
-UndoListWidget::UndoListWidget(score::CommandStack& s) : m_stack{s}
+UndoListWidget::UndoListWidget(score::CommandStack& s)
+    : m_stack{s}, m_model{s}
 {
+  // Only the rows on screen are measured and asked their description
+  setUniformItemSizes(true);
+  setModel(&m_model);
+
   on_stackChanged();
 
   con(m_stack,
@@ -21,29 +27,27 @@ UndoListWidget::UndoListWidget(score::CommandStack& s) : m_stack{s}
       this,
       &score::UndoListWidget::on_stackChanged);
   connect(
-      this,
-      &QListWidget::currentRowChanged,
+      selectionModel(),
+      &QItemSelectionModel::currentRowChanged,
       &m_stack,
-      &CommandStack::setIndex);
+      [this](const QModelIndex& cur, const QModelIndex&) {
+        if (cur.isValid())
+          m_stack.setIndex(cur.row());
+      });
 }
 
-UndoListWidget::~UndoListWidget() = default;
+UndoListWidget::~UndoListWidget()
+{
+  // The view has to let go of the model before it is destroyed
+  setModel(nullptr);
+}
 
 void UndoListWidget::on_stackChanged()
 {
-  this->blockSignals(true);
-  clear();
-  addItem("<Clean state>");
-  for (int i = 0; i < m_stack.size(); i++)
-  {
-    auto cmd = m_stack.command(i);
-    addItem(cmd->description());
-  }
-
-  this->setCurrentRow(
-      m_stack.currentIndex(),
-      QItemSelectionModel::SelectionFlag::ClearAndSelect);
-
-  this->blockSignals(false);
+  QSignalBlocker blocker{selectionModel()};
+  const auto idx = m_model.index(m_stack.currentIndex());
+  selectionModel()->setCurrentIndex(
+      idx, QItemSelectionModel::SelectionFlag::ClearAndSelect);
+  scrollTo(idx);
 }
 } // namespace score
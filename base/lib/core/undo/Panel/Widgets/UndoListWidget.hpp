@@ -1,6 +1,7 @@
 #pragma once
+#include <core/undo/Panel/Widgets/UndoListModel.hpp>
 
-#include <QListWidget>
+#include <QListView>
 
 #include <verdigris>
 
@@ -8,7 +9,7 @@ namespace score
 {
 class CommandStack;
 
-class UndoListWidget final : public QListWidget
+class UndoListWidget final : public QListView
 {
   W_OBJECT(UndoListWidget)
 public:
@@ -21,5 +22,6 @@ public:
 
 private:
   score::CommandStack& m_stack;
+  UndoListModel m_model;
 };
 } // namespace score
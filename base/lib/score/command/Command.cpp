@@ -33,6 +33,11 @@ void Command::setTimestamp(quint32 stmp)
   m_timestamp = std::chrono::duration<quint32>(stmp);
 }*/
 
+bool Command::mergeWith(const Command&)
+{
+  return false;
+}
+
 QByteArray Command::serialize() const
 {
   QByteArray arr;
@@ -17,11 +17,10 @@ struct ApplicationContext;
  * TimestampedCommand instead ?
  * What if other plug-ins also want to add functionality ?
  *
- * Note: for mergeWith put two timestamps, one for the initial command (5 sec)
- * and one for each
- * new command merged.
- *
  * Commands are serializable / deserializable.
+ *
+ * Consecutive commands can be merged in a single entry of the command stack
+ * through mergeWith: see CommandStack::redoAndMerge for the time windows.
  */
 class SCORE_LIB_BASE_EXPORT Command
 {
@@ -40,6 +39,15 @@ public:
 
   virtual QString description() const = 0;
 
+  /**
+   * @brief Folds a command which was applied right after this one.
+   *
+   * Returns false if the commands cannot be merged, e.g. if they do not
+   * change the same property of the same object.
+   * Undoing this command afterwards must undo both of them.
+   */
+  virtual bool mergeWith(const Command& other);
+
 protected:
   virtual void serializeImpl(DataStreamInput&) const = 0;
   virtual void deserializeImpl(DataStreamOutput&) = 0;
@@ -25,6 +25,8 @@ public:
 
   void redoAndPush(score::Command* cmd) const { m_stack.redoAndPush(cmd); }
 
+  void redoAndMerge(score::Command* cmd) const { m_stack.redoAndMerge(cmd); }
+
   void disableActions() const { m_stack.disableActions(); }
 
   void enableActions() const { m_stack.enableActions(); }
@@ -49,11 +49,14 @@ public:
 
   //! When the command is finished and can be sent to the undo - redo stack.
   //! For instance on mouse release.
+  //! With SendStrategy::Merge, it is merged in the previous command
+  //! when possible.
+  template <typename Strategy = SendStrategy::Quiet>
   void commit()
   {
     if (m_cmd)
     {
-      SendStrategy::Quiet::send(stack(), m_cmd.release());
+      Strategy::send(stack(), m_cmd.release());
       stack().enableActions();
     }
   }
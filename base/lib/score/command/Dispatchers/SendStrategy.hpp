@@ -21,6 +21,16 @@ struct Quiet
   }
 };
 
+//! Merges the command in the previous one when possible.
+struct Merge
+{
+  static void
+  send(const score::CommandStackFacade& stack, score::Command* other)
+  {
+    stack.redoAndMerge(other);
+  }
+};
+
 struct UndoRedo
 {
   static void
@@ -19,6 +19,19 @@ void score::PropertyCommand::redo(const score::DocumentContext& ctx) const
       m_property.toUtf8().constData(), m_new);
 }
 
+bool score::PropertyCommand::mergeWith(const Command& other)
+{
+  if (other.key() != key() || other.parentKey() != parentKey())
+    return false;
+
+  const auto& cmd = static_cast<const PropertyCommand&>(other);
+  if (!(cmd.m_path == m_path) || cmd.m_property != m_property)
+    return false;
+
+  m_new = cmd.m_new;
+  return true;
+}
+
 void score::PropertyCommand::serializeImpl(DataStreamInput& s) const
 {
   s << m_path << m_property << m_old << m_new;
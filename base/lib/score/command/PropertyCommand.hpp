@@ -39,6 +39,9 @@ public:
   void undo(const score::DocumentContext& ctx) const final override;
   void redo(const score::DocumentContext& ctx) const final override;
 
+  //! Merges the commands which change the same property of the same object.
+  bool mergeWith(const Command& other) final override;
+
   template <typename Path_T>
   void update(const Path_T&, QVariant newval)
   {
@@ -92,6 +95,21 @@ public:
     (m_path.find(ctx).*T::set)(m_new);
   }
 
+  //! Merges the commands which change the same property of the same object.
+  bool mergeWith(const score::Command& other) final override
+  {
+    // The key identifies the command class, hence the property.
+    if (other.key() != key() || other.parentKey() != parentKey())
+      return false;
+
+    const auto& cmd = static_cast<const PropertyCommand_T&>(other);
+    if (!(cmd.m_path == m_path))
+      return false;
+
+    m_new = cmd.m_new;
+    return true;
+  }
+
 private:
   void serializeImpl(DataStreamInput& s) const final override
   {
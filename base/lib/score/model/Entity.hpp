@@ -35,6 +35,7 @@ class EntityMapInserter<score::Entity<T>>
     obj->metadata().setName(new_name);
 
     map.unsafe_map().insert(obj);
+    IdentityRegistry::add(*obj);
 
     map.mutable_added(*obj);
     map.added(*obj);
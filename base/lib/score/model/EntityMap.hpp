@@ -1,5 +1,6 @@
 #pragma once
 #include <score/model/IdentifiedObjectMap.hpp>
+#include <score/model/path/IdentityRegistry.hpp>
 
 #include <nano_signal_slot.hpp>
 
@@ -27,6 +28,11 @@ public:
  * Differences :
  *  - Deletes objects when they are removed ("ownership")
  *  - Sends signals after adding and before deleting.
+ *  - Can add a batch of objects at once with add_range: `mutable_added` is
+ *    still sent for each object, but `added` is replaced by a single
+ *    `added_range`; observers of `added` which may see such batches
+ *    have to connect to both.
+ *  - Registers the objects in the IdentityRegistry, to find them by path.
  *
  * Tthe parent of the childs are the parents of the map.
  * Hence the objects shall not be deleted upon deletion of the map
@@ -53,19 +59,39 @@ public:
   T& at(const Id<T>& id) INLINE_EXPORT { return m_map.at(id); }
   T& at(const Id<T>& id) const INLINE_EXPORT { return m_map.at(id); }
   auto find(const Id<T>& id) const INLINE_EXPORT { return m_map.find(id); }
+  Id<T> nextId() const INLINE_EXPORT { return m_map.nextId(); }
 
   // public:
   mutable Nano::Signal<void(T&)> mutable_added;
   mutable Nano::Signal<void(const T&)> added;
+  mutable Nano::Signal<void(const std::vector<T*>&)> added_range;
   mutable Nano::Signal<void(const T&)> removing;
   mutable Nano::Signal<void(const T&)> removed;
   mutable Nano::Signal<void()> orderChanged;
 
   void add(T* t) INLINE_EXPORT { EntityMapInserter<T>{}.add(*this, t); }
 
+  void add_range(const std::vector<T*>& objs) INLINE_EXPORT
+  {
+    if (objs.empty())
+      return;
+
+    for (auto t : objs)
+    {
+      SCORE_ASSERT(t);
+      m_map.insert(t);
+      IdentityRegistry::add(*t);
+    }
+
+    for (auto t : objs)
+      mutable_added(*t);
+    added_range(objs);
+  }
+
   void erase(T& elt) INLINE_EXPORT
   {
     removing(elt);
+    IdentityRegistry::remove(elt);
     m_map.remove(elt.id());
     removed(elt);
   }
@@ -73,6 +99,7 @@ public:
   void remove(T& elt) INLINE_EXPORT
   {
     removing(elt);
+    IdentityRegistry::remove(elt);
     m_map.remove(elt.id());
     removed(elt);
     delete &elt;
@@ -81,6 +108,7 @@ public:
   void remove(T* elt) INLINE_EXPORT
   {
     removing(*elt);
+    IdentityRegistry::remove(*elt);
     m_map.remove(elt->id());
     removed(*elt);
     delete elt;
@@ -92,6 +120,7 @@ public:
     auto& elt = *it->second.first;
 
     removing(elt);
+    IdentityRegistry::remove(elt);
     m_map.remove(it);
     removed(elt);
     delete &elt;
@@ -114,8 +143,16 @@ void EntityMapInserter<T>::add(EntityMap<T>& map, T* t)
 {
   SCORE_ASSERT(t);
   map.unsafe_map().insert(t);
+  IdentityRegistry::add(*t);
 
   map.mutable_added(*t);
   map.added(*t);
 }
 } // namespace score
+
+//! Generates an id in O(1) from the highest id ever added to the map.
+template <typename T>
+auto getStrongId(const score::EntityMap<T>& v) -> Id<T>
+{
+  return v.nextId();
+}
@@ -2,6 +2,8 @@
 // it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 #include "IdentifiedObjectAbstract.hpp"
 
+#include <score/model/path/IdentityRegistry.hpp>
+
 #include <score/tools/std/HashMap.hpp>
 
 #include <wobjectimpl.h>
@@ -9,4 +11,5 @@ W_OBJECT_IMPL(IdentifiedObjectAbstract)
 IdentifiedObjectAbstract::~IdentifiedObjectAbstract()
 {
   identified_object_destroyed(this);
+  score::IdentityRegistry::remove(*this);
 }
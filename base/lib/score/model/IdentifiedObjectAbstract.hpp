@@ -29,6 +29,16 @@ public:
 
   virtual void resetCache() = 0;
 
+  /**
+   * @brief For objects whose children are created on demand.
+   *
+   * Creates the children which were not created yet, e.g. those of a
+   * scene loaded lazily; ObjectPath calls it before giving up on a child.
+   *
+   * @return true if children were created.
+   */
+  virtual bool loadLazyChildren() { return false; }
+
 protected:
   using QObject::QObject;
   IdentifiedObjectAbstract(const QString& name, QObject* parent) noexcept
@@ -4,7 +4,8 @@
 
 #include <tsl/hopscotch_map.h>
 
-#include <list>
+#include <algorithm>
+#include <iterator>
 #include <vector>
 // This file contains a fast map for items based on their identifier,
 // based on boost's multi-index maps.
@@ -17,6 +18,67 @@ class IdContainer
 {
 };
 
+namespace score
+{
+/**
+ * @brief Iterates over a vector of pointers, skipping the null ones.
+ *
+ * Used by IdContainer, whose erased slots are set to null until the
+ * storage is compacted.
+ */
+template <typename base_iterator_t>
+struct slot_iterator
+{
+  using self_type = slot_iterator;
+  using value_type = std::remove_pointer_t<
+      typename std::iterator_traits<base_iterator_t>::value_type>;
+  using reference = value_type&;
+  using pointer = value_type*;
+  using iterator_category = std::forward_iterator_tag;
+  using difference_type = int;
+
+  base_iterator_t it;
+  base_iterator_t end;
+
+  slot_iterator(base_iterator_t i, base_iterator_t e) noexcept
+      : it{i}, end{e}
+  {
+    skip();
+  }
+
+  self_type& operator++() noexcept
+  {
+    ++it;
+    skip();
+    return *this;
+  }
+  self_type operator++(int) noexcept
+  {
+    self_type i = *this;
+    ++*this;
+    return i;
+  }
+
+  value_type& operator*() const noexcept { return **it; }
+  value_type* operator->() const noexcept { return *it; }
+  bool operator==(const self_type& rhs) const noexcept
+  {
+    return it == rhs.it;
+  }
+  bool operator!=(const self_type& rhs) const noexcept
+  {
+    return it != rhs.it;
+  }
+
+private:
+  void skip() noexcept
+  {
+    while (it != end && !*it)
+      ++it;
+  }
+};
+}
+
 // We have to write two implementations since const_mem_fun does not handle
 // inheritance.
 
@@ -24,11 +86,16 @@ class IdContainer
  * IdentifiedObject<T> and don't have an id() method by themselves, e.g. all
  * the model objects.
  *
- * Additionnally, items are ordered; iteration occurs on the ordered iterators.
+ * Additionnally, items are ordered: iteration starts from the most recently
+ * inserted item.
  *
  * In the implementation :
- * * `get<0>()` gets the hashed (like std::unordered_map) iterator.
- * * `get<1>()` gets the ordered (like std::vector) iterator.
+ * * `m_map` maps each id to its element and to its slot in `m_order`.
+ * * `m_order` stores the elements contiguously in insertion order.
+ *   Erasing sets the slot to null, which keeps the other slots stable;
+ *   the null slots are compacted away on insertion once they make up
+ *   half of the storage.
+ * * `m_maxId` is the largest id ever inserted, used to generate new ids.
  */
 template <typename Element, typename Model>
 class IdContainer<
@@ -38,19 +105,18 @@ class IdContainer<
 {
 public:
   using model_type = Model;
-  using order_t = std::list<Element*>;
-  using map_t = tsl::hopscotch_map<
-      Id<Model>,
-      std::pair<Element*, typename order_t::iterator>>;
+  using order_t = std::vector<Element*>;
+  using map_t = tsl::hopscotch_map<Id<Model>, std::pair<Element*, std::size_t>>;
   map_t m_map;
   order_t m_order;
+  int32_t m_maxId{};
 
   using value_type = Element;
-  using iterator = score::indirect_iterator<typename order_t::iterator>;
+  using iterator = score::slot_iterator<typename order_t::reverse_iterator>;
   using const_iterator
-      = score::indirect_iterator<typename order_t::const_iterator>;
+      = score::slot_iterator<typename order_t::const_reverse_iterator>;
   using const_reverse_iterator
-      = score::indirect_iterator<typename order_t::const_reverse_iterator>;
+      = score::slot_iterator<typename order_t::const_iterator>;
 
   IdContainer() INLINE_EXPORT = default;
   IdContainer(const IdContainer& other) = delete;
@@ -61,38 +127,30 @@ public:
   ~IdContainer() INLINE_EXPORT
   {
     // To ensure that children are deleted before their parents
-    for (auto elt : m_order)
+    for (auto it = m_order.rbegin(); it != m_order.rend(); ++it)
     {
-      delete elt;
+      delete *it;
     }
   }
 
-  auto& ordered() INLINE_EXPORT { return m_order; }
-
   const_iterator begin() const INLINE_EXPORT
   {
-    return score::make_indirect_iterator(this->m_order.begin());
+    return {this->m_order.crbegin(), this->m_order.crend()};
   }
   const_reverse_iterator rbegin() const INLINE_EXPORT
   {
-    return score::make_indirect_iterator(this->m_order.rbegin());
-  }
-  const_iterator cbegin() const INLINE_EXPORT
-  {
-    return score::make_indirect_iterator(this->m_order.cbegin());
+    return {this->m_order.cbegin(), this->m_order.cend()};
   }
+  const_iterator cbegin() const INLINE_EXPORT { return begin(); }
   const_iterator end() const INLINE_EXPORT
   {
-    return score::make_indirect_iterator(this->m_order.end());
+    return {this->m_order.crend(), this->m_order.crend()};
   }
   const_reverse_iterator rend() const INLINE_EXPORT
   {
-    return score::make_indirect_iterator(this->m_order.rend());
-  }
-  const_iterator cend() const INLINE_EXPORT
-  {
-    return score::make_indirect_iterator(this->m_order.cend());
+    return {this->m_order.cend(), this->m_order.cend()};
   }
+  const_iterator cend() const INLINE_EXPORT { return end(); }
 
   std::size_t size() const INLINE_EXPORT { return m_map.size(); }
 
@@ -100,19 +158,35 @@ public:
 
   std::vector<Element*> as_vec() const INLINE_EXPORT
   {
-    return std::vector<Element*>(m_order.begin(), m_order.end());
+    std::vector<Element*> v;
+    v.reserve(m_map.size());
+    for (auto it = begin(); it != end(); ++it)
+      v.push_back(&*it);
+    return v;
   }
 
   score::IndirectContainer<Element> as_indirect_vec() const INLINE_EXPORT
   {
-    return score::IndirectContainer<Element>(m_order.begin(), m_order.end());
+    auto v = as_vec();
+    return score::IndirectContainer<Element>(v.begin(), v.end());
   }
 
   void insert(value_type* t) INLINE_EXPORT
   {
     SCORE_ASSERT(m_map.find(t->id()) == m_map.end());
-    m_order.push_front(t);
-    m_map.insert({t->id(), {t, m_order.begin()}});
+    if (m_order.size() >= 16 && m_map.size() < m_order.size() / 2)
+      compact();
+
+    m_map.insert({t->id(), {t, m_order.size()}});
+    m_order.push_back(t);
+    m_maxId = std::max(m_maxId, t->id().val());
+  }
+
+  //! An id greater than all the ids inserted so far, even if they
+  //! were removed since.
+  Id<Model> nextId() const INLINE_EXPORT
+  {
+    return Id<Model>{m_maxId + 1};
   }
 
   void remove(typename map_t::iterator it) INLINE_EXPORT
@@ -121,7 +195,7 @@ public:
 
     if (it != this->m_map.end())
     {
-      m_order.erase(it->second.second);
+      m_order[it->second.second] = nullptr;
       m_map.erase(it);
     }
   }
@@ -131,7 +205,7 @@ public:
 
     if (it != this->m_map.end())
     {
-      m_order.erase(it->second.second);
+      m_order[it->second.second] = nullptr;
       m_map.erase(it);
     }
   }
@@ -142,6 +216,7 @@ public:
   {
     m_map.clear();
     m_order.clear();
+    m_maxId = 0;
     // TODO why no delete ?!
     // e.g. in some cases (Curve::Model::clear()) it deletes afterwards
     // but not in Scenario destructor
@@ -152,12 +227,14 @@ public:
     auto it = this->m_map.find(id);
     if (it != this->m_map.end())
     {
-      return score::make_indirect_iterator(
-          (typename order_t::const_iterator)it->second.second);
+      // The reverse iterator which dereferences to the slot
+      return {typename order_t::const_reverse_iterator(
+                  this->m_order.cbegin() + it->second.second + 1),
+              this->m_order.crend()};
     }
     else
     {
-      return score::make_indirect_iterator(this->m_order.end());
+      return end();
     }
   }
 
@@ -175,6 +252,23 @@ public:
     id.m_ptr = item->second.first;
     return safe_cast<Element&>(*item->second.first);
   }
+
+private:
+  //! Removes the null slots, keeping the order of the elements.
+  void compact() INLINE_EXPORT
+  {
+    std::size_t slot = 0;
+    for (auto elt : m_order)
+    {
+      if (elt)
+      {
+        m_order[slot] = elt;
+        m_map.find(elt->id()).value().second = slot;
+        slot++;
+      }
+    }
+    m_order.resize(slot);
+  }
 };
 
 /** This specialization is for classes which directly have an id() method
@@ -0,0 +1,89 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include <score/model/IdentifiedObjectAbstract.hpp>
+#include <score/model/path/IdentityRegistry.hpp>
+#include <score/tools/std/HashMap.hpp>
+
+#include <ossia/detail/hash.hpp>
+
+#include <QHash>
+
+namespace score
+{
+namespace
+{
+struct RegistryKey
+{
+  const QObject* parent{};
+  QString name;
+  int32_t id{};
+
+  friend bool operator==(const RegistryKey& lhs, const RegistryKey& rhs) noexcept
+  {
+    return lhs.parent == rhs.parent && lhs.id == rhs.id
+           && lhs.name == rhs.name;
+  }
+};
+
+struct RegistryKeyHash
+{
+  std::size_t operator()(const RegistryKey& k) const noexcept
+  {
+    std::size_t seed = std::hash<const QObject*>{}(k.parent);
+    ossia::hash_combine(seed, qHash(k.name));
+    ossia::hash_combine(seed, k.id);
+    return seed;
+  }
+};
+
+struct Registry
+{
+  score::hash_map<RegistryKey, IdentifiedObjectAbstract*, RegistryKeyHash>
+      objects;
+  // Used to unregister an object even if its parent or name changed
+  score::hash_map<const IdentifiedObjectAbstract*, RegistryKey> keys;
+};
+
+Registry& registry() noexcept
+{
+  static Registry r;
+  return r;
+}
+}
+
+void IdentityRegistry::add(IdentifiedObjectAbstract& obj)
+{
+  remove(obj);
+
+  auto& r = registry();
+  RegistryKey key{obj.parent(), obj.objectName(), obj.id_val()};
+  r.objects[key] = &obj;
+  r.keys.insert({&obj, std::move(key)});
+}
+
+void IdentityRegistry::remove(IdentifiedObjectAbstract& obj) noexcept
+{
+  auto& r = registry();
+  auto it = r.keys.find(&obj);
+  if (it == r.keys.end())
+    return;
+
+  // Another object may have been registered with the same key since.
+  auto obj_it = r.objects.find(it->second);
+  if (obj_it != r.objects.end() && obj_it->second == &obj)
+    r.objects.erase(obj_it);
+
+  r.keys.erase(it);
+}
+
+IdentifiedObjectAbstract* IdentityRegistry::find(
+    const QObject* parent,
+    const ObjectIdentifier& id) noexcept
+{
+  auto& r = registry();
+  auto it = r.objects.find(RegistryKey{parent, id.objectName(), id.id()});
+  if (it == r.objects.end())
+    return nullptr;
+  return it->second;
+}
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <score/model/path/ObjectIdentifier.hpp>
+
+#include <score_lib_base_export.h>
+
+class IdentifiedObjectAbstract;
+class QObject;
+namespace score
+{
+/**
+ * @brief The IdentityRegistry class
+ *
+ * Maps each (parent, object name, id) to the corresponding identified object.
+ *
+ * Objects are registered when they are added to an EntityMap, and
+ * unregistered when they are removed from it or destroyed.
+ * This allows ObjectPath to resolve each level of a path with a hash lookup
+ * instead of QObject::findChildren; objects which are not stored in an
+ * EntityMap are still found through the QObject hierarchy.
+ */
+class SCORE_LIB_BASE_EXPORT IdentityRegistry
+{
+public:
+  static void add(IdentifiedObjectAbstract& obj);
+  static void remove(IdentifiedObjectAbstract& obj) noexcept;
+
+  //! Returns nullptr if no such object is registered.
+  static IdentifiedObjectAbstract*
+  find(const QObject* parent, const ObjectIdentifier& id) noexcept;
+};
+}
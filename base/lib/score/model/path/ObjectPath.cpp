@@ -2,6 +2,7 @@
 // it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 #include <score/application/ApplicationContext.hpp>
 #include <score/model/IdentifiedObjectAbstract.hpp>
+#include <score/model/path/IdentityRegistry.hpp>
 #include <score/model/path/ObjectIdentifier.hpp>
 #include <score/model/path/ObjectPath.hpp>
 #include <score/model/path/RelativePath.hpp>
@@ -52,6 +53,24 @@ operator()(const ObjectPath& path) const
 }
 } // namespace std
 
+namespace
+{
+//! Looks for a child registered by an EntityMap, after creating the
+//! children of the parent if they are loaded lazily.
+IdentifiedObjectAbstract*
+findRegistered(QObject* parent, const ObjectIdentifier& id)
+{
+  if (auto child = score::IdentityRegistry::find(parent, id))
+    return child;
+
+  auto lazy = qobject_cast<IdentifiedObjectAbstract*>(parent);
+  if (lazy && lazy->loadLazyChildren())
+    return score::IdentityRegistry::find(parent, id);
+
+  return nullptr;
+}
+}
+
 ObjectPath ObjectPath::pathBetweenObjects(
     const QObject* const parent_obj,
     const QObject* target_object)
@@ -128,6 +147,13 @@ QObject* ObjectPath::find_impl(const score::DocumentContext& ctx) const
 
   for (const auto& currentObjIdentifier : m_objectIdentifiers)
   {
+    if (auto child = findRegistered(obj, currentObjIdentifier))
+    {
+      obj = child;
+      continue;
+    }
+
+    // Objects which are not stored in an EntityMap
     auto found_children = obj->findChildren<IdentifiedObjectAbstract*>(
         currentObjIdentifier.objectName(), Qt::FindDirectChildrenOnly);
 
@@ -145,6 +171,13 @@ QObject* ObjectPath::find_impl_unsafe(const score::DocumentContext& ctx) const
 
   for (const auto& currentObjIdentifier : m_objectIdentifiers)
   {
+    if (auto child = findRegistered(obj, currentObjIdentifier))
+    {
+      obj = child;
+      continue;
+    }
+
+    // Objects which are not stored in an EntityMap
     auto found_children = obj->findChildren<IdentifiedObjectAbstract*>(
         currentObjIdentifier.objectName(), Qt::FindDirectChildrenOnly);
 
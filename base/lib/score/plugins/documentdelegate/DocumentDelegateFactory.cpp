@@ -1,6 +1,40 @@
 // This is an open source non-commercial project. Dear PVS-Studio, please check
 // it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 #include "DocumentDelegateFactory.hpp"
+
+#include <score/serialization/BinaryDocument.hpp>
+#include <score/serialization/JSONStreamReader.hpp>
+#include <score/serialization/JSONVisitor.hpp>
+
+#include <stdexcept>
+
 score::DocumentDelegateFactory::~DocumentDelegateFactory() = default;
 
+void score::DocumentDelegateFactory::loadJson(
+    JSONStreamReader& reader,
+    const score::DocumentContext& ctx,
+    DocumentDelegateModel*& ptr,
+    DocumentModel* parent)
+{
+  JSONObject::Deserializer des{reader.readValue().toObject()};
+  if (reader.hasError())
+    throw std::runtime_error(reader.errorString().toStdString());
+
+  load(des.toVariant(), ctx, ptr, parent);
+}
+
+void score::DocumentDelegateFactory::loadBinary(
+    const BinaryDocumentReader& reader,
+    const QString& path,
+    const score::DocumentContext& ctx,
+    DocumentDelegateModel*& ptr,
+    DocumentModel* parent)
+{
+  JSONObject::Deserializer des{reader.toJson()[path].toObject()};
+  if (reader.hasError())
+    throw std::runtime_error(reader.errorString().toStdString());
+
+  load(des.toVariant(), ctx, ptr, parent);
+}
+
 score::DocumentDelegateList::~DocumentDelegateList() {}
@@ -4,7 +4,10 @@
 #include <score_lib_base_export.h>
 
 struct VisitorVariant;
+class BinaryDocumentReader;
+class JSONStreamReader;
 class QObject;
+class QString;
 namespace score
 {
 class DocumentDelegateModel;
@@ -53,6 +56,23 @@ public:
       DocumentDelegateModel*& ptr,
       DocumentModel* parent)
       = 0;
+
+  //! Loads the model from the text of the "Document" member of a save file.
+  //! By default it is read as a whole, then loaded with load.
+  virtual void loadJson(
+      JSONStreamReader& reader,
+      const score::DocumentContext& ctx,
+      DocumentDelegateModel*& ptr,
+      DocumentModel* parent);
+
+  //! Loads the model from a binary save file, where it is under path.
+  //! By default the whole JSON object is rebuilt, then loaded with load.
+  virtual void loadBinary(
+      const BinaryDocumentReader& reader,
+      const QString& path,
+      const score::DocumentContext& ctx,
+      DocumentDelegateModel*& ptr,
+      DocumentModel* parent);
 };
 
 class SCORE_LIB_BASE_EXPORT DocumentDelegateList final
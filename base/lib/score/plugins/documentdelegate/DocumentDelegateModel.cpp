@@ -2,9 +2,32 @@
 // it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 #include "DocumentDelegateModel.hpp"
 
+#include <score/serialization/JSONStreamWriter.hpp>
+#include <score/serialization/JSONVisitor.hpp>
+
 #include <wobjectimpl.h>
 W_OBJECT_IMPL(score::DocumentDelegateModel)
 namespace score
 {
 DocumentDelegateModel::~DocumentDelegateModel() {}
+
+void DocumentDelegateModel::serializeJson(JSONStreamWriter& writer) const
+{
+  JSONObject::Serializer s;
+  TSerializer<JSONObject, IdentifiedObject<DocumentDelegateModel>>::readFrom(
+      s, *this);
+  serialize(s.toVariant());
+  writer.value(s.obj);
+}
+
+QJsonObject DocumentDelegateModel::serializeBinary(
+    BinaryDocumentWriter&,
+    const QString&) const
+{
+  JSONObject::Serializer s;
+  TSerializer<JSONObject, IdentifiedObject<DocumentDelegateModel>>::readFrom(
+      s, *this);
+  serialize(s.toVariant());
+  return s.obj;
+}
 } // namespace score
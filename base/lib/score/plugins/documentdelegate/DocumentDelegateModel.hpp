@@ -2,7 +2,11 @@
 #include <score/model/IdentifiedObject.hpp>
 #include <score/selection/Selection.hpp>
 
+#include <QJsonObject>
+
 struct VisitorVariant;
+class BinaryDocumentWriter;
+class JSONStreamWriter;
 
 namespace score
 {
@@ -15,6 +19,17 @@ public:
   virtual ~DocumentDelegateModel();
 
   virtual void serialize(const VisitorVariant&) const = 0;
+
+  //! Writes the same JSON object as Document::saveDocumentModelAsJson.
+  //! Can be reimplemented to write large models one part at a time.
+  virtual void serializeJson(JSONStreamWriter& writer) const;
+
+  //! Returns the same JSON object as serializeJson, except for the large
+  //! arrays which can instead be added as sections of the writer, under
+  //! path. By default there is no such section.
+  virtual QJsonObject
+  serializeBinary(BinaryDocumentWriter& writer, const QString& path) const;
+
   virtual void savedDocumentAs(const QString& origPath, const QString& newPath) = 0;
 };
 } // namespace score
@@ -0,0 +1,623 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "BinaryDocument.hpp"
+
+#include <QIODevice>
+#include <QMutexLocker>
+#include <QtEndian>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+constexpr char magic[8] = {'S', 'E', 'G', 'M', 'E', 'N', 'T', 'B'};
+constexpr quint32 formatVersion = 1;
+constexpr quint64 fileHeaderSize = 24;
+constexpr quint64 sectionEntrySize = 32;
+constexpr quint32 noString = std::numeric_limits<quint32>::max();
+
+//! Nesting depth above which a value is considered corrupted.
+constexpr int maxDepth = 512;
+
+enum SectionKind : quint32
+{
+  HeaderSection = 1,
+  ArraySection = 2,
+  StringSection = 3
+};
+
+enum Tag : quint8
+{
+  NullTag,
+  FalseTag,
+  TrueTag,
+  IntTag,
+  DoubleTag,
+  StringTag,
+  ArrayTag,
+  ObjectTag
+};
+
+template <typename T>
+void append(QByteArray& out, T v)
+{
+  uchar buf[sizeof(T)];
+  qToLittleEndian<T>(v, buf);
+  out.append(reinterpret_cast<const char*>(buf), int(sizeof(T)));
+}
+
+template <typename T>
+T read(const uchar* p)
+{
+  return qFromLittleEndian<T>(p);
+}
+
+quint64 padding(quint64 size)
+{
+  return (8 - size % 8) % 8;
+}
+
+//! True if the double can be stored as an integer without loss.
+bool isInt(double d)
+{
+  return d >= std::numeric_limits<qint32>::min()
+         && d <= std::numeric_limits<qint32>::max() && std::trunc(d) == d
+         && !(d == 0. && std::signbit(d));
+}
+
+QJsonValue takeAt(QJsonObject& obj, const QStringList& path, int i = 0)
+{
+  if (i == path.size() - 1)
+    return obj.take(path[i]);
+
+  auto it = obj.find(path[i]);
+  if (it == obj.end() || !it->isObject())
+    return QJsonValue{QJsonValue::Undefined};
+
+  auto child = it->toObject();
+  auto res = takeAt(child, path, i + 1);
+  obj[path[i]] = child;
+  return res;
+}
+
+void insertAt(
+    QJsonObject& obj,
+    const QStringList& path,
+    const QJsonValue& v,
+    int i = 0)
+{
+  if (i == path.size() - 1)
+  {
+    obj[path[i]] = v;
+    return;
+  }
+
+  auto child = obj[path[i]].toObject();
+  insertAt(child, path, v, i + 1);
+  obj[path[i]] = child;
+}
+
+struct Decoder
+{
+  const uchar* cur{};
+  const uchar* end{};
+  const std::vector<QString>& strings;
+  bool ok{true};
+
+  template <typename T>
+  T take()
+  {
+    if (!ok || std::size_t(end - cur) < sizeof(T))
+    {
+      ok = false;
+      return T{};
+    }
+    T v = read<T>(cur);
+    cur += sizeof(T);
+    return v;
+  }
+
+  QString string()
+  {
+    const auto i = take<quint32>();
+    if (i >= strings.size())
+    {
+      ok = false;
+      return {};
+    }
+    return strings[i];
+  }
+
+  QJsonValue value(int depth = 0)
+  {
+    if (depth > maxDepth)
+      ok = false;
+
+    const auto tag = take<quint8>();
+    if (!ok)
+      return {};
+
+    switch (tag)
+    {
+      case NullTag:
+        return QJsonValue{QJsonValue::Null};
+      case FalseTag:
+        return false;
+      case TrueTag:
+        return true;
+      case IntTag:
+        return take<qint32>();
+      case DoubleTag:
+      {
+        const auto bits = take<quint64>();
+        double d;
+        std::memcpy(&d, &bits, sizeof(d));
+        return d;
+      }
+      case StringTag:
+        return string();
+      case ArrayTag:
+      {
+        // Each element takes at least one byte, hence a corrupted count
+        // stops at the end of the data.
+        const auto n = take<quint32>();
+        QJsonArray arr;
+        for (quint32 i = 0; i < n && ok; i++)
+          arr.append(value(depth + 1));
+        return arr;
+      }
+      case ObjectTag:
+      {
+        const auto n = take<quint32>();
+        QJsonObject obj;
+        for (quint32 i = 0; i < n && ok; i++)
+        {
+          auto k = string();
+          obj.insert(k, value(depth + 1));
+        }
+        return obj;
+      }
+      default:
+        ok = false;
+        return {};
+    }
+  }
+};
+} // namespace
+
+BinaryDocumentWriter::BinaryDocumentWriter() = default;
+BinaryDocumentWriter::~BinaryDocumentWriter() = default;
+
+void BinaryDocumentWriter::setHeader(const QJsonObject& obj)
+{
+  m_header.clear();
+  encode(m_header, obj);
+}
+
+void BinaryDocumentWriter::addSection(const QString& path)
+{
+  string(path);
+  m_sections.push_back(Section{path, {0}, {}});
+}
+
+void BinaryDocumentWriter::addEntry(const QString& path, const QJsonValue& v)
+{
+  auto& s = section(path);
+  encode(s.data, v);
+  s.offsets.push_back(quint64(s.data.size()));
+}
+
+bool BinaryDocumentWriter::write(QIODevice& device) const
+{
+  struct Part
+  {
+    quint32 kind{};
+    quint32 name{};
+    quint32 count{};
+    QByteArray table;
+    QByteArray data;
+  };
+
+  std::vector<Part> parts;
+  parts.reserve(m_sections.size() + 2);
+  parts.push_back(Part{HeaderSection, noString, 1, {}, m_header});
+
+  for (const auto& s : m_sections)
+  {
+    Part p{ArraySection,
+           m_stringIndices.find(s.path)->second,
+           quint32(s.offsets.size() - 1),
+           {},
+           s.data};
+
+    const quint64 tableSize = 8 * s.offsets.size();
+    p.table.reserve(int(tableSize));
+    for (auto offset : s.offsets)
+      append<quint64>(p.table, tableSize + offset);
+    parts.push_back(std::move(p));
+  }
+
+  {
+    Part p{StringSection, noString, quint32(m_strings.size()), {}, {}};
+    append<quint32>(p.table, 0);
+    for (const auto& str : m_strings)
+    {
+      p.data.append(str.toUtf8());
+      append<quint32>(p.table, quint32(p.data.size()));
+    }
+    parts.push_back(std::move(p));
+  }
+
+  QByteArray table;
+  quint64 offset = fileHeaderSize + sectionEntrySize * parts.size();
+  for (const auto& p : parts)
+  {
+    const quint64 size = quint64(p.table.size()) + quint64(p.data.size());
+    append<quint32>(table, p.kind);
+    append<quint32>(table, p.name);
+    append<quint32>(table, p.count);
+    append<quint32>(table, 0);
+    append<quint64>(table, offset);
+    append<quint64>(table, size);
+    offset += size + padding(size);
+  }
+
+  QByteArray head;
+  head.append(magic, sizeof(magic));
+  append<quint32>(head, formatVersion);
+  append<quint32>(head, quint32(parts.size()));
+  append<quint64>(head, offset);
+
+  bool ok = true;
+  auto put = [&](const QByteArray& data) {
+    if (ok && !data.isEmpty())
+      ok = device.write(data) == data.size();
+  };
+
+  put(head);
+  put(table);
+  for (const auto& p : parts)
+  {
+    put(p.table);
+    put(p.data);
+    put(QByteArray(
+        int(padding(quint64(p.table.size()) + quint64(p.data.size()))),
+        '\0'));
+  }
+  return ok;
+}
+
+bool BinaryDocumentWriter::fromJson(
+    QJsonObject doc,
+    const QStringList& sections,
+    QIODevice& device)
+{
+  BinaryDocumentWriter w;
+  for (const auto& path : sections)
+  {
+    const auto keys = path.split('/');
+    const auto v = takeAt(doc, keys);
+    if (v.isArray())
+    {
+      w.addSection(path);
+      for (const auto& e : v.toArray())
+        w.addEntry(path, e);
+    }
+    else if (!v.isUndefined())
+    {
+      // Not an array: left as is in the header
+      insertAt(doc, keys, v);
+    }
+  }
+
+  w.setHeader(doc);
+  return w.write(device);
+}
+
+BinaryDocumentWriter::Section&
+BinaryDocumentWriter::section(const QString& path)
+{
+  for (auto it = m_sections.rbegin(); it != m_sections.rend(); ++it)
+  {
+    if (it->path == path)
+      return *it;
+  }
+
+  addSection(path);
+  return m_sections.back();
+}
+
+quint32 BinaryDocumentWriter::string(const QString& str)
+{
+  auto it = m_stringIndices.find(str);
+  if (it != m_stringIndices.end())
+    return it->second;
+
+  const auto idx = quint32(m_strings.size());
+  m_strings.push_back(str);
+  m_stringIndices.insert({str, idx});
+  return idx;
+}
+
+void BinaryDocumentWriter::encode(QByteArray& out, const QJsonValue& v)
+{
+  switch (v.type())
+  {
+    case QJsonValue::Null:
+    case QJsonValue::Undefined:
+      out.append(char(NullTag));
+      break;
+    case QJsonValue::Bool:
+      out.append(char(v.toBool() ? TrueTag : FalseTag));
+      break;
+    case QJsonValue::Double:
+    {
+      const double d = v.toDouble();
+      if (isInt(d))
+      {
+        out.append(char(IntTag));
+        append<qint32>(out, qint32(d));
+      }
+      else
+      {
+        quint64 bits;
+        std::memcpy(&bits, &d, sizeof(d));
+        out.append(char(DoubleTag));
+        append<quint64>(out, bits);
+      }
+      break;
+    }
+    case QJsonValue::String:
+      out.append(char(StringTag));
+      append<quint32>(out, string(v.toString()));
+      break;
+    case QJsonValue::Array:
+    {
+      const auto arr = v.toArray();
+      out.append(char(ArrayTag));
+      append<quint32>(out, quint32(arr.size()));
+      for (const auto& e : arr)
+        encode(out, e);
+      break;
+    }
+    case QJsonValue::Object:
+    {
+      const auto obj = v.toObject();
+      out.append(char(ObjectTag));
+      append<quint32>(out, quint32(obj.size()));
+      for (auto it = obj.begin(); it != obj.end(); ++it)
+      {
+        append<quint32>(out, string(it.key()));
+        encode(out, it.value());
+      }
+      break;
+    }
+  }
+}
+
+bool BinaryDocumentReader::isBinaryDocument(const QByteArray& data)
+{
+  return data.size() >= int(sizeof(magic))
+         && std::memcmp(data.constData(), magic, sizeof(magic)) == 0;
+}
+
+BinaryDocumentReader::BinaryDocumentReader() = default;
+BinaryDocumentReader::~BinaryDocumentReader() = default;
+
+bool BinaryDocumentReader::open(const QString& path)
+{
+  m_file.setFileName(path);
+  if (!m_file.open(QIODevice::ReadOnly))
+    return fail(m_file.errorString());
+
+  m_size = quint64(m_file.size());
+  if (m_size < fileHeaderSize)
+    return fail(QStringLiteral("Not a binary document"));
+
+  m_data = m_file.map(0, m_file.size());
+  if (!m_data)
+    return fail(m_file.errorString());
+
+  return parse();
+}
+
+bool BinaryDocumentReader::open(const QByteArray& data)
+{
+  m_data = reinterpret_cast<const uchar*>(data.constData());
+  m_size = quint64(data.size());
+  return parse();
+}
+
+QStringList BinaryDocumentReader::sections() const
+{
+  QStringList res;
+  for (const auto& s : m_sections)
+    res.push_back(s.path);
+  return res;
+}
+
+int BinaryDocumentReader::entryCount(const QString& section) const
+{
+  auto s = findSection(section);
+  return s ? int(s->count) : 0;
+}
+
+QJsonValue BinaryDocumentReader::entry(const QString& section, int i) const
+{
+  auto s = findSection(section);
+  if (!s || i < 0 || quint32(i) >= s->count)
+  {
+    fail(QStringLiteral("No element %1 in %2").arg(i).arg(section));
+    return QJsonValue{QJsonValue::Undefined};
+  }
+
+  // The offsets were checked in parse()
+  const auto begin = read<quint64>(s->begin + 8 * quint64(i));
+  const auto end = read<quint64>(s->begin + 8 * (quint64(i) + 1));
+  Decoder d{s->begin + begin, s->begin + end, m_strings};
+  const auto v = d.value();
+  if (!d.ok || d.cur != d.end)
+  {
+    fail(QStringLiteral("Invalid element %1 in %2").arg(i).arg(section));
+    return QJsonValue{QJsonValue::Undefined};
+  }
+  return v;
+}
+
+QJsonArray BinaryDocumentReader::entries(const QString& section) const
+{
+  QJsonArray arr;
+  const int n = entryCount(section);
+  for (int i = 0; i < n; i++)
+    arr.append(entry(section, i));
+  return arr;
+}
+
+QJsonObject BinaryDocumentReader::toJson() const
+{
+  QJsonObject doc = m_header;
+  for (const auto& s : m_sections)
+    insertAt(doc, s.path.split('/'), entries(s.path));
+  return doc;
+}
+
+bool BinaryDocumentReader::parse()
+{
+  m_strings.clear();
+  m_sections.clear();
+  m_header = QJsonObject{};
+  m_error.clear();
+
+  if (m_size < fileHeaderSize
+      || std::memcmp(m_data, magic, sizeof(magic)) != 0)
+    return fail(QStringLiteral("Not a binary document"));
+
+  const auto version = read<quint32>(m_data + 8);
+  if (version > formatVersion)
+    return fail(
+        QStringLiteral("Unsupported binary document version %1").arg(version));
+
+  const auto count = read<quint32>(m_data + 12);
+  if (read<quint64>(m_data + 16) != m_size)
+    return fail(QStringLiteral("Truncated binary document"));
+  if ((m_size - fileHeaderSize) / sectionEntrySize < count)
+    return fail(QStringLiteral("Invalid section table"));
+
+  struct Entry
+  {
+    quint32 kind{};
+    quint32 name{};
+    quint32 count{};
+    const uchar* begin{};
+    quint64 size{};
+  };
+
+  std::vector<Entry> entries;
+  const Entry* headerSection{};
+  const Entry* stringSection{};
+  entries.reserve(count);
+  for (quint32 i = 0; i < count; i++)
+  {
+    const uchar* p = m_data + fileHeaderSize + sectionEntrySize * i;
+    const auto offset = read<quint64>(p + 16);
+    const auto size = read<quint64>(p + 24);
+    if (offset > m_size || size > m_size - offset)
+      return fail(QStringLiteral("Section %1 out of bounds").arg(i));
+
+    entries.push_back(Entry{read<quint32>(p),
+                            read<quint32>(p + 4),
+                            read<quint32>(p + 8),
+                            m_data + offset,
+                            size});
+  }
+
+  // Unknown sections are ignored, for newer minor versions.
+  for (const auto& e : entries)
+  {
+    if (e.kind == HeaderSection)
+      headerSection = &e;
+    else if (e.kind == StringSection)
+      stringSection = &e;
+  }
+
+  if (!headerSection || !stringSection)
+    return fail(QStringLiteral("Missing header or string table"));
+
+  {
+    const quint64 tableSize = 4 * (quint64(stringSection->count) + 1);
+    if (tableSize > stringSection->size)
+      return fail(QStringLiteral("Invalid string table"));
+
+    const auto offsets = stringSection->begin;
+    const auto text = reinterpret_cast<const char*>(offsets + tableSize);
+    const quint64 textSize = stringSection->size - tableSize;
+    m_strings.reserve(stringSection->count);
+    for (quint32 i = 0; i < stringSection->count; i++)
+    {
+      const auto begin = read<quint32>(offsets + 4 * quint64(i));
+      const auto end = read<quint32>(offsets + 4 * (quint64(i) + 1));
+      if (begin > end || end > textSize)
+        return fail(QStringLiteral("Invalid string table"));
+      m_strings.push_back(QString::fromUtf8(text + begin, int(end - begin)));
+    }
+  }
+
+  for (const auto& e : entries)
+  {
+    if (e.kind != ArraySection)
+      continue;
+
+    if (e.name >= m_strings.size())
+      return fail(QStringLiteral("Invalid section name"));
+
+    const quint64 tableSize = 8 * (quint64(e.count) + 1);
+    if (tableSize > e.size)
+      return fail(QStringLiteral("Invalid section %1").arg(m_strings[e.name]));
+
+    // Checking the offsets here means that entry() only has to check the
+    // content of the elements.
+    quint64 prev = tableSize;
+    if (read<quint64>(e.begin) != tableSize)
+      return fail(QStringLiteral("Invalid section %1").arg(m_strings[e.name]));
+    for (quint32 i = 1; i <= e.count; i++)
+    {
+      const auto offset = read<quint64>(e.begin + 8 * quint64(i));
+      if (offset < prev || offset > e.size)
+        return fail(
+            QStringLiteral("Invalid section %1").arg(m_strings[e.name]));
+      prev = offset;
+    }
+
+    m_sections.push_back(Section{m_strings[e.name], e.count, e.begin, e.size});
+  }
+
+  const auto headerBegin = headerSection->begin;
+  Decoder d{headerBegin, headerBegin + headerSection->size, m_strings};
+  const auto v = d.value();
+  if (!d.ok || !v.isObject())
+    return fail(QStringLiteral("Invalid header"));
+
+  m_header = v.toObject();
+  return true;
+}
+
+bool BinaryDocumentReader::fail(const QString& err) const
+{
+  QMutexLocker lock{&m_errorMutex};
+  if (m_error.isEmpty())
+    m_error = err;
+  return false;
+}
+
+const BinaryDocumentReader::Section*
+BinaryDocumentReader::findSection(const QString& path) const
+{
+  for (const auto& s : m_sections)
+  {
+    if (s.path == path)
+      return &s;
+  }
+  return nullptr;
+}
@@ -0,0 +1,181 @@
+#pragma once
+#include <QByteArray>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+#include <score/tools/std/HashMap.hpp>
+#include <score/tools/std/StringHash.hpp>
+
+#include <score_lib_base_export.h>
+
+#include <vector>
+
+class QIODevice;
+
+/**
+ * \file BinaryDocument.hpp
+ *
+ * Binary container for JSON save files, split in sections so that the
+ * large arrays of a document, e.g. the scenes, can be read one element at
+ * a time without going through the rest of the file.
+ *
+ * All the integers are little-endian, the offsets are from the beginning
+ * of the file and the sections are aligned on 8 bytes:
+ *
+ * \code
+ * char[8] magic: "SEGMENTB"
+ * u32     format version
+ * u32     section count
+ * u64     file size
+ *
+ * section table, for each section:
+ *   u32 kind: 1 = header, 2 = array, 3 = string table
+ *   u32 for arrays, index of the path of the array in the string table
+ *   u32 element count: 1 for the header, strings for the string table
+ *   u32 reserved
+ *   u64 offset
+ *   u64 size
+ *
+ * header:       one value, the document without its array sections
+ * array:        u64[count + 1] offsets from the beginning of the section,
+ *               then one value per element
+ * string table: u32[count + 1] offsets from the end of the offsets,
+ *               then the UTF-8 text of the strings
+ * \endcode
+ *
+ * A value is a tag byte followed by its content: null, false, true,
+ * a 32-bit integer or a double, a string index, or the size of an array
+ * followed by its values or of an object followed by pairs of key index
+ * and value. All the keys and string values are stored once in the
+ * string table.
+ *
+ * The conversion from and to JSON is lossless: the numbers are stored
+ * as integers only when this gives back the same double.
+ */
+
+//! Writes a binary document; see BinaryDocument.hpp for the format.
+class SCORE_LIB_BASE_EXPORT BinaryDocumentWriter
+{
+public:
+  BinaryDocumentWriter();
+  ~BinaryDocumentWriter();
+
+  //! The document, without the arrays which are written as sections.
+  void setHeader(const QJsonObject& obj);
+
+  /**
+   * @brief Adds an array stored as a section.
+   *
+   * The path is the list of the keys leading to the array from the root
+   * of the document, separated by '/', e.g. "Document/Process/Scenes".
+   */
+  void addSection(const QString& path);
+
+  //! Appends an element to the last section with this path.
+  void addEntry(const QString& path, const QJsonValue& v);
+
+  //! Returns false if the device could not be written to.
+  bool write(QIODevice& device) const;
+
+  //! Converts a whole JSON document. The arrays found at the given paths
+  //! are stored as sections.
+  static bool
+  fromJson(QJsonObject doc, const QStringList& sections, QIODevice& device);
+
+private:
+  struct Section
+  {
+    QString path;
+    std::vector<quint64> offsets;
+    QByteArray data;
+  };
+
+  Section& section(const QString& path);
+  quint32 string(const QString& str);
+  void encode(QByteArray& out, const QJsonValue& v);
+
+  QByteArray m_header;
+  std::vector<Section> m_sections;
+  std::vector<QString> m_strings;
+  score::hash_map<QString, quint32> m_stringIndices;
+};
+
+/**
+ * @brief Reads a binary document.
+ *
+ * The string table and the header are decoded when opening the document,
+ * the elements of the sections only when they are requested: e.g. a
+ * single scene can be read from a mapped file without touching the pages
+ * of the other scenes.
+ */
+class SCORE_LIB_BASE_EXPORT BinaryDocumentReader
+{
+public:
+  //! True if the data starts like a binary document.
+  static bool isBinaryDocument(const QByteArray& data);
+
+  BinaryDocumentReader();
+  ~BinaryDocumentReader();
+  BinaryDocumentReader(const BinaryDocumentReader&) = delete;
+  BinaryDocumentReader& operator=(const BinaryDocumentReader&) = delete;
+
+  //! Maps the file in memory for the lifetime of the reader.
+  bool open(const QString& path);
+
+  //! Reads from data, which must outlive the reader, e.g. a file
+  //! already mapped with QByteArray::fromRawData.
+  bool open(const QByteArray& data);
+
+  //! Set when opening fails, or when an element cannot be decoded.
+  bool hasError() const noexcept { return !m_error.isEmpty(); }
+  QString errorString() const { return m_error; }
+
+  //! The document, without its array sections.
+  const QJsonObject& header() const noexcept { return m_header; }
+
+  //! Paths of the array sections, in the order of the file.
+  QStringList sections() const;
+
+  //! Number of elements of a section, 0 if there is no such section.
+  int entryCount(const QString& section) const;
+
+  //! Decodes a single element of a section.
+  //! Returns an undefined value if it is invalid or out of bounds.
+  //! Elements can be decoded by several threads at once; hasError is
+  //! then only meaningful once they are all done.
+  QJsonValue entry(const QString& section, int i) const;
+
+  //! Decodes a whole section.
+  QJsonArray entries(const QString& section) const;
+
+  //! The whole document, as it was given to BinaryDocumentWriter::fromJson.
+  QJsonObject toJson() const;
+
+private:
+  struct Section
+  {
+    QString path;
+    quint32 count{};
+    const uchar* begin{};
+    quint64 size{};
+  };
+
+  bool parse();
+  bool fail(const QString& err) const;
+  const Section* findSection(const QString& path) const;
+
+  QFile m_file;
+  const uchar* m_data{};
+  quint64 m_size{};
+
+  std::vector<QString> m_strings;
+  std::vector<Section> m_sections;
+  QJsonObject m_header;
+  mutable QString m_error;
+  mutable QMutex m_errorMutex;
+};
@@ -0,0 +1,331 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "JSONStreamReader.hpp"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <cstring>
+
+JSONStreamReader::JSONStreamReader(const QByteArray& text)
+    : m_begin{text.constData()}
+    , m_cur{text.constData()}
+    , m_end{text.constData() + text.size()}
+    , m_tokenBegin{text.constData()}
+{
+}
+
+JSONStreamReader::Token JSONStreamReader::next()
+{
+  if (hasError())
+    return Invalid;
+
+  skipWhitespace();
+  m_tokenBegin = m_cur;
+
+  if (m_containers.empty())
+  {
+    if (m_started)
+    {
+      if (m_cur != m_end)
+        return fail("Garbage at the end of the document");
+      return EndOfDocument;
+    }
+  }
+  else
+  {
+    if (m_cur == m_end)
+      return fail("Unterminated object or array");
+
+    const bool object = m_containers.back();
+    if (!m_afterKey && *m_cur == (object ? '}' : ']'))
+    {
+      ++m_cur;
+      m_containers.pop_back();
+      m_afterElement = true;
+      return object ? EndObject : EndArray;
+    }
+
+    if (m_afterElement)
+    {
+      if (*m_cur != ',')
+        return fail("Missing ','");
+      ++m_cur;
+      m_afterElement = false;
+      skipWhitespace();
+      m_tokenBegin = m_cur;
+    }
+
+    if (object && !m_afterKey)
+    {
+      if (!parseString(m_key))
+        return fail("Invalid key");
+
+      skipWhitespace();
+      if (m_cur == m_end || *m_cur != ':')
+        return fail("Missing ':'");
+      ++m_cur;
+
+      m_afterKey = true;
+      return Key;
+    }
+  }
+
+  skipWhitespace();
+  m_tokenBegin = m_cur;
+  if (m_cur == m_end)
+    return fail("Missing value");
+
+  m_afterKey = false;
+  m_started = true;
+  switch (*m_cur)
+  {
+    case '{':
+      ++m_cur;
+      m_containers.push_back(true);
+      m_afterElement = false;
+      return BeginObject;
+    case '[':
+      ++m_cur;
+      m_containers.push_back(false);
+      m_afterElement = false;
+      return BeginArray;
+    default:
+      if (!parseScalar())
+        return fail("Invalid value");
+      m_afterElement = true;
+      return Value;
+  }
+}
+
+JSONStreamReader::Token JSONStreamReader::peek()
+{
+  JSONStreamReader copy{*this};
+  return copy.next();
+}
+
+bool JSONStreamReader::hasNext()
+{
+  switch (peek())
+  {
+    case EndObject:
+    case EndArray:
+    case EndOfDocument:
+    case Invalid:
+      return false;
+    default:
+      return true;
+  }
+}
+
+QJsonValue JSONStreamReader::readValue()
+{
+  const QByteArray raw = rawValue();
+  if (raw.isEmpty())
+    return {};
+
+  if (raw[0] != '{' && raw[0] != '[')
+    return m_value;
+
+  QJsonParseError err;
+  const auto doc = QJsonDocument::fromJson(raw, &err);
+  if (err.error != QJsonParseError::NoError)
+  {
+    m_cur = m_tokenBegin + err.offset;
+    fail(err.errorString().toUtf8().constData());
+    return {};
+  }
+
+  if (doc.isObject())
+    return doc.object();
+  return doc.array();
+}
+
+QByteArray JSONStreamReader::rawValue()
+{
+  switch (next())
+  {
+    case Value:
+      break;
+    case BeginObject:
+    case BeginArray:
+      if (!skipContainer())
+        return {};
+      break;
+    default:
+      fail("Expected a value");
+      return {};
+  }
+
+  return QByteArray::fromRawData(m_tokenBegin, int(m_cur - m_tokenBegin));
+}
+
+QString JSONStreamReader::errorString() const
+{
+  return m_error;
+}
+
+void JSONStreamReader::skipWhitespace()
+{
+  while (m_cur != m_end
+         && (*m_cur == ' ' || *m_cur == '\n' || *m_cur == '\r'
+             || *m_cur == '\t'))
+    ++m_cur;
+}
+
+bool JSONStreamReader::parseString(QString& str)
+{
+  if (m_cur == m_end || *m_cur != '"')
+    return false;
+
+  const char* const quote = m_cur++;
+  bool escaped = false;
+  while (m_cur != m_end && *m_cur != '"')
+  {
+    if (*m_cur == '\\')
+    {
+      escaped = true;
+      if (++m_cur == m_end)
+        return false;
+    }
+    else if (uchar(*m_cur) < 0x20)
+    {
+      return false;
+    }
+    ++m_cur;
+  }
+
+  if (m_cur == m_end)
+    return false;
+  ++m_cur;
+
+  if (!escaped)
+  {
+    str = QString::fromUtf8(quote + 1, int(m_cur - quote - 2));
+    return true;
+  }
+
+  // Escape sequences are rare: let Qt decode them.
+  QByteArray arr;
+  arr.reserve(int(m_cur - quote) + 2);
+  arr.append('[');
+  arr.append(quote, int(m_cur - quote));
+  arr.append(']');
+
+  const auto doc = QJsonDocument::fromJson(arr);
+  if (!doc.isArray() || doc.array().size() != 1)
+    return false;
+
+  str = doc.array().first().toString();
+  return true;
+}
+
+bool JSONStreamReader::parseScalar()
+{
+  const auto literal = [this](const char* lit) {
+    const auto n = std::strlen(lit);
+    if (std::size_t(m_end - m_cur) < n || std::memcmp(m_cur, lit, n) != 0)
+      return false;
+    m_cur += n;
+    return true;
+  };
+
+  switch (*m_cur)
+  {
+    case '"':
+    {
+      QString str;
+      if (!parseString(str))
+        return false;
+      m_value = str;
+      return true;
+    }
+    case 't':
+      m_value = true;
+      return literal("true");
+    case 'f':
+      m_value = false;
+      return literal("false");
+    case 'n':
+      m_value = QJsonValue{QJsonValue::Null};
+      return literal("null");
+    default:
+      break;
+  }
+
+  const char* const start = m_cur;
+  while (m_cur != m_end
+         && ((*m_cur >= '0' && *m_cur <= '9') || *m_cur == '-'
+             || *m_cur == '+' || *m_cur == '.' || *m_cur == 'e'
+             || *m_cur == 'E'))
+    ++m_cur;
+
+  if (start == m_cur)
+    return false;
+
+  bool ok = false;
+  const double d
+      = QByteArray::fromRawData(start, int(m_cur - start)).toDouble(&ok);
+  if (!ok)
+    return false;
+
+  m_value = d;
+  return true;
+}
+
+bool JSONStreamReader::skipContainer()
+{
+  // Only the structure is checked here, not the content: it is fully
+  // parsed when the value is read.
+  int depth = 1;
+  while (m_cur != m_end)
+  {
+    switch (*m_cur++)
+    {
+      case '"':
+        while (m_cur != m_end && *m_cur != '"')
+        {
+          if (*m_cur == '\\' && ++m_cur == m_end)
+            break;
+          ++m_cur;
+        }
+        if (m_cur == m_end)
+        {
+          fail("Unterminated string");
+          return false;
+        }
+        ++m_cur;
+        break;
+      case '{':
+      case '[':
+        ++depth;
+        break;
+      case '}':
+      case ']':
+        if (--depth == 0)
+        {
+          m_containers.pop_back();
+          m_afterElement = true;
+          return true;
+        }
+        break;
+      default:
+        break;
+    }
+  }
+
+  fail("Unterminated object or array");
+  return false;
+}
+
+JSONStreamReader::Token JSONStreamReader::fail(const char* err)
+{
+  if (!hasError())
+  {
+    m_error = QStringLiteral("%1 at offset %2")
+                  .arg(QString::fromUtf8(err))
+                  .arg(m_cur - m_begin);
+  }
+  return Invalid;
+}
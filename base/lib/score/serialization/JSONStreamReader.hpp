@@ -0,0 +1,108 @@
+#pragma once
+#include <QByteArray>
+#include <QJsonValue>
+#include <QString>
+
+#include <score_lib_base_export.h>
+
+#include <vector>
+
+/**
+ * @brief Pull parser over JSON text.
+ *
+ * Goes through the document one token at a time without building it,
+ * so that only the parts which are needed as a whole are materialized,
+ * with readValue, e.g. one scene of a document at a time.
+ *
+ * The text must outlive the reader, and the slices returned by rawValue.
+ *
+ * Usage:
+ * \code
+ * JSONStreamReader r{text};
+ * r.next(); // BeginObject
+ * while (r.hasNext())
+ * {
+ *   r.next(); // Key
+ *   if (r.key() == "Scenes")
+ *   {
+ *     r.next(); // BeginArray
+ *     while (r.hasNext())
+ *       load(r.readValue().toObject());
+ *     r.next(); // EndArray
+ *   }
+ *   else
+ *     r.skipValue();
+ * }
+ * r.next(); // EndObject
+ * \endcode
+ */
+class SCORE_LIB_BASE_EXPORT JSONStreamReader
+{
+public:
+  enum Token
+  {
+    Invalid,
+    BeginObject,
+    EndObject,
+    BeginArray,
+    EndArray,
+    Key,
+    Value,
+    EndOfDocument
+  };
+
+  explicit JSONStreamReader(const QByteArray& text);
+
+  //! Reads the next token. Returns Invalid from the first error on.
+  Token next();
+
+  //! The token that next() would return.
+  Token peek();
+
+  //! True if the current object or array has another member.
+  bool hasNext();
+
+  //! The name read by the last Key token.
+  const QString& key() const noexcept { return m_key; }
+
+  //! The scalar read by the last Value token.
+  const QJsonValue& value() const noexcept { return m_value; }
+
+  //! Reads the whole next value, where next() would return BeginObject,
+  //! BeginArray or Value.
+  QJsonValue readValue();
+
+  //! Text of the whole next value, without copy and without parsing
+  //! it entirely: it can then be read by another JSONStreamReader, or
+  //! by QJsonDocument, e.g. on another thread.
+  QByteArray rawValue();
+
+  //! Goes past the next value.
+  void skipValue() { rawValue(); }
+
+  bool hasError() const noexcept { return !m_error.isEmpty(); }
+  QString errorString() const;
+
+private:
+  void skipWhitespace();
+  bool parseString(QString& str);
+  bool parseScalar();
+  bool skipContainer();
+  Token fail(const char* err);
+
+  const char* m_begin{};
+  const char* m_cur{};
+  const char* m_end{};
+  const char* m_tokenBegin{};
+
+  //! true for an object, false for an array
+  std::vector<bool> m_containers;
+
+  QString m_key;
+  QJsonValue m_value;
+  QString m_error;
+
+  bool m_afterKey{};
+  bool m_afterElement{};
+  bool m_started{};
+};
@@ -0,0 +1,189 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "JSONStreamWriter.hpp"
+
+#include <QIODevice>
+#include <QJsonArray>
+
+#include <algorithm>
+
+namespace
+{
+//! Strings and numbers are formatted by Qt so that the output is identical.
+QByteArray formatScalar(const QJsonValue& v)
+{
+  QByteArray res = QJsonDocument{QJsonArray{v}}.toJson(QJsonDocument::Compact);
+  // Remove the brackets
+  return res.mid(1, res.size() - 2);
+}
+
+QByteArray indentation(std::size_t depth)
+{
+  return QByteArray(int(4 * depth), ' ');
+}
+} // namespace
+
+JSONStreamWriter::JSONStreamWriter(
+    QIODevice& device,
+    QJsonDocument::JsonFormat format)
+    : m_device{device}, m_compact{format == QJsonDocument::Compact}
+{
+}
+
+void JSONStreamWriter::beginObject()
+{
+  beginContainer('{');
+}
+
+void JSONStreamWriter::endObject()
+{
+  endContainer('}');
+}
+
+void JSONStreamWriter::beginArray()
+{
+  beginContainer('[');
+}
+
+void JSONStreamWriter::endArray()
+{
+  endContainer(']');
+}
+
+void JSONStreamWriter::key(const QString& k)
+{
+  beginElement();
+  write(formatScalar(k));
+  write(m_compact ? ":" : ": ");
+  m_afterKey = true;
+}
+
+void JSONStreamWriter::value(const QJsonValue& v)
+{
+  rawValue(formatValue(v));
+}
+
+QByteArray JSONStreamWriter::formatValue(const QJsonValue& v) const
+{
+  QJsonDocument doc;
+  if (v.isObject())
+    doc.setObject(v.toObject());
+  else if (v.isArray())
+    doc.setArray(v.toArray());
+  else
+    return formatScalar(v);
+
+  if (m_compact)
+    return doc.toJson(QJsonDocument::Compact);
+
+  // Qt formats the nested values like top-level documents,
+  // only more indented. The line breaks can only be between elements
+  // as they are escaped in strings.
+  QByteArray json = doc.toJson(QJsonDocument::Indented);
+  json.chop(1);
+  if (!m_empty.empty())
+    json.replace('\n', "\n" + indentation(m_empty.size()));
+  return json;
+}
+
+void JSONStreamWriter::rawValue(const QByteArray& text)
+{
+  beginElement();
+  write(text);
+}
+
+void JSONStreamWriter::members(
+    const QJsonObject& obj,
+    std::vector<StreamedMember> streamed)
+{
+  std::sort(
+      streamed.begin(), streamed.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first < rhs.first;
+      });
+
+  auto s_it = streamed.begin();
+  const auto s_end = streamed.end();
+  for (auto it = obj.begin(); it != obj.end(); ++it)
+  {
+    while (s_it != s_end && s_it->first < it.key())
+    {
+      key(s_it->first);
+      s_it->second();
+      ++s_it;
+    }
+
+    if (s_it != s_end && s_it->first == it.key())
+    {
+      key(s_it->first);
+      s_it->second();
+      ++s_it;
+      continue;
+    }
+
+    key(it.key());
+    value(it.value());
+  }
+
+  for (; s_it != s_end; ++s_it)
+  {
+    key(s_it->first);
+    s_it->second();
+  }
+}
+
+void JSONStreamWriter::beginElement()
+{
+  if (m_afterKey)
+  {
+    m_afterKey = false;
+    return;
+  }
+
+  if (m_empty.empty())
+    return;
+
+  if (!m_empty.back())
+    write(m_compact ? "," : ",\n");
+  m_empty.back() = false;
+
+  if (!m_compact)
+    write(indentation(m_empty.size()));
+}
+
+void JSONStreamWriter::beginContainer(char c)
+{
+  beginElement();
+  write(QByteArray(1, c));
+  if (!m_compact)
+    write("\n");
+  m_empty.push_back(true);
+}
+
+void JSONStreamWriter::endContainer(char c)
+{
+  const bool empty = m_empty.back();
+  m_empty.pop_back();
+
+  if (!m_compact)
+  {
+    if (!empty)
+      write("\n");
+    write(indentation(m_empty.size()));
+  }
+  write(QByteArray(1, c));
+
+  // Same as QJsonDocument::toJson for the whole document
+  if (m_empty.empty() && !m_compact)
+    write("\n");
+}
+
+void JSONStreamWriter::write(const QByteArray& data)
+{
+  if (m_ok)
+    m_ok = m_device.write(data) == data.size();
+}
+
+void JSONStreamWriter::write(const char* data)
+{
+  write(QByteArray::fromRawData(data, int(qstrlen(data))));
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include <QByteArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QString>
+
+#include <score_lib_base_export.h>
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+class QIODevice;
+
+/**
+ * @brief Writes JSON to a device while it is being generated.
+ *
+ * The output is the same as QJsonDocument::toJson with the same format,
+ * as long as the keys of each object are written in the order of
+ * QJsonObject, i.e. sorted. This way a document can be written one part
+ * at a time, instead of building the whole QJsonObject, then the whole
+ * text, in memory.
+ *
+ * Usage:
+ * \code
+ * JSONStreamWriter w{file};
+ * w.beginObject();
+ * w.key("Scenes");
+ * w.beginArray();
+ * for(auto& scene : scenes)
+ *   w.value(toJsonObject(scene));
+ * w.endArray();
+ * w.endObject();
+ * \endcode
+ */
+class SCORE_LIB_BASE_EXPORT JSONStreamWriter
+{
+public:
+  //! A member written by a function instead of being taken from an object.
+  using StreamedMember = std::pair<QString, std::function<void()>>;
+
+  explicit JSONStreamWriter(
+      QIODevice& device,
+      QJsonDocument::JsonFormat format = QJsonDocument::Indented);
+  JSONStreamWriter(const JSONStreamWriter&) = delete;
+  JSONStreamWriter& operator=(const JSONStreamWriter&) = delete;
+
+  void beginObject();
+  void endObject();
+
+  void beginArray();
+  void endArray();
+
+  //! Name of the next value, in an object.
+  void key(const QString& k);
+
+  //! Writes a value, which may be a whole object or array.
+  void value(const QJsonValue& v);
+
+  /**
+   * @brief Text that value(v) would write at the current position.
+   *
+   * It only depends on the format and on the depth, so it can be kept and
+   * written again with rawValue, e.g. for the parts of a document which
+   * did not change since it was last saved.
+   */
+  QByteArray formatValue(const QJsonValue& v) const;
+
+  //! Writes a value formatted by formatValue at the same depth.
+  void rawValue(const QByteArray& text);
+
+  //! Number of objects and arrays open at the current position.
+  std::size_t depth() const noexcept { return m_empty.size(); }
+
+  bool compact() const noexcept { return m_compact; }
+
+  /**
+   * @brief Writes the members of an object, in the order of QJsonObject.
+   *
+   * The streamed members are written by calling their function, which
+   * must write exactly one value, at their position in the key order;
+   * they replace the member of the same name in obj if any.
+   */
+  void members(const QJsonObject& obj, std::vector<StreamedMember> streamed);
+
+  //! False if writing to the device failed at some point.
+  bool ok() const noexcept { return m_ok; }
+
+private:
+  void beginElement();
+  void beginContainer(char c);
+  void endContainer(char c);
+  void write(const QByteArray& data);
+  void write(const char* data);
+
+  QIODevice& m_device;
+
+  //! For each open object or array, whether nothing was written in it yet.
+  std::vector<bool> m_empty;
+
+  bool m_compact{};
+  bool m_afterKey{};
+  bool m_ok{true};
+};
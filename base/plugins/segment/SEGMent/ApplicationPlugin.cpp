@@ -7,6 +7,8 @@
 #include <score/document/DocumentInterface.hpp>
 #include <score/plugins/documentdelegate/DocumentDelegateView.hpp>
 
+#include <core/application/ApplicationSettings.hpp>
+#include <core/application/OpenDocumentsFile.hpp>
 #include <core/document/Document.hpp>
 #include <core/document/DocumentModel.hpp>
 #include <core/document/DocumentView.hpp>
@@ -28,12 +30,14 @@
 #include <QMimeData>
 #include <QSaveFile>
 #include <QSplitter>
+#include <QTimer>
 #include <QTabWidget>
 #include <QTextBrowser>
 #include <QTranslator>
 #include <QDesktopWidget>
 #include <QDesktopServices>
 
+#include <SEGMent/Autosave.hpp>
 #include <SEGMent/Document.hpp>
 #include <SEGMent/Commands/Creation.hpp>
 #include <SEGMent/Commands/Deletion.hpp>
@@ -42,10 +46,12 @@
 #include <SEGMent/Items/SceneWindow.hpp>
 #include <SEGMent/Model/Layer/ProcessView.hpp>
 #include <SEGMent/Model/Scene.hpp>
+#include <SEGMent/Model/Snapshot.hpp>
 #include <SEGMent/Exporter.hpp>
 #include <SEGMent/HelpWidget.hpp>
 #include <SEGMent/ObjectCopier.hpp>
 #include <SEGMent/ObjectPaster.hpp>
+#include <SEGMent/RenderProfiler.hpp>
 #include <SEGMent/SoundPlayer.hpp>
 #include <SEGMent/Visitors.hpp>
 #include <SEGMent/ZOrder.hpp>
@@ -57,7 +63,6 @@
 #include <score_git_info.hpp>
 #include <wobjectimpl.h>
 
-#include <unordered_set>
 #include <typeindex>
 
 namespace SEGMent
@@ -79,6 +84,8 @@ QString applicationPath()
 
 ApplicationPlugin::ApplicationPlugin(const score::GUIApplicationContext& presenter)
   : score::GUIApplicationPlugin{presenter}
+  , m_restoringBackups{presenter.applicationSettings.tryToRestore
+                       && score::OpenDocumentsFile::exists()}
 {
   m_copy_act = new QAction(tr("Copy"), this);
   m_paste_act = new QAction(tr("Paste"), this);
@@ -125,6 +132,11 @@ ApplicationPlugin::ApplicationPlugin(const score::GUIApplicationContext& present
 
   m_testGame->setShortcut(QKeySequence("CTRL+Enter"));
   m_testGame->setShortcutContext(Qt::ApplicationShortcut);
+
+  m_showProfiler = new QAction(tr("Show render profiler"), this);
+  m_showProfiler->setCheckable(true);
+  m_exportRenderTrace = new QAction(tr("Export render trace"), this);
+  m_exportRenderTrace->setEnabled(false);
   /*
     m_tools = new QActionGroup{this};
     m_tools->addAction(m_moveAction);
@@ -188,6 +200,9 @@ ApplicationPlugin::ApplicationPlugin(const score::GUIApplicationContext& present
   connect(m_testGame, &QAction::triggered, this, &ApplicationPlugin::on_testGame);
   connect(m_exportGame, &QAction::triggered, this, &ApplicationPlugin::on_exportGame);
 
+  connect(m_showProfiler, &QAction::toggled, this, &ApplicationPlugin::on_showProfiler);
+  connect(m_exportRenderTrace, &QAction::triggered, this, &ApplicationPlugin::on_exportRenderTrace);
+
   m_help = new QDialog;
   auto lay = new QHBoxLayout{m_help};
 
@@ -196,6 +211,25 @@ ApplicationPlugin::ApplicationPlugin(const score::GUIApplicationContext& present
   lay->addWidget(w);
 }
 
+bool ApplicationPlugin::handleStartup()
+{
+  if (canOfferRecovery())
+    Autosave::offerRecovery(context);
+
+  // The usual startup goes on, e.g. restoring after a crash. The documents
+  // restored then are created before the events are processed.
+  QTimer::singleShot(0, this, [this] { m_restoringBackups = false; });
+  return false;
+}
+
+bool ApplicationPlugin::canOfferRecovery() const
+{
+  // After a crash, the documents are restored from their backups instead.
+  // Without a user to answer, e.g. for the benchmarks, nothing is asked.
+  return context.applicationSettings.gui && !m_restoringBackups
+         && QGuiApplication::platformName() != QLatin1String("offscreen");
+}
+
 void ApplicationPlugin::on_createdDocument(score::Document& doc)
 {
   // m_moveAction->setChecked(true);
@@ -205,12 +239,59 @@ void ApplicationPlugin::on_createdDocument(score::Document& doc)
   w->addAction(m_paste_act);
   w->addAction(m_delete_act);
 
+  auto& model = doc.model().modelDelegate();
+  new Autosave{doc, static_cast<const SEGMent::DocumentModel&>(model), &model};
+  if (canOfferRecovery())
+    Autosave::offerRecovery(context, doc);
+
   on_recenter(doc);
 }
 
 void ApplicationPlugin::on_documentChanged(score::Document* olddoc, score::Document* newdoc)
 {
+  // The profiler overlay follows the visible document
+  if (olddoc && olddoc->view())
+  {
+    if (auto v = dynamic_cast<DocumentView*>(&olddoc->view()->viewDelegate()))
+      v->view().setProfilerVisible(false);
+  }
+  if (newdoc && newdoc->view())
+  {
+    if (auto v = dynamic_cast<DocumentView*>(&newdoc->view()->viewDelegate()))
+      v->view().setProfilerVisible(RenderProfiler::instance().enabled());
+  }
+}
+
+void ApplicationPlugin::on_showProfiler(bool b)
+{
+  RenderProfiler::instance().setEnabled(b);
+  m_exportRenderTrace->setEnabled(b);
+
+  score::Document* doc = currentDocument();
+  if (!doc || !doc->view())
+    return;
+
+  if (auto v = dynamic_cast<DocumentView*>(&doc->view()->viewDelegate()))
+    v->view().setProfilerVisible(b);
+}
+
+void ApplicationPlugin::on_exportRenderTrace()
+{
+  auto file = QFileDialog::getSaveFileName(
+      this->context.mainWindow,
+      tr("Export render trace"),
+      {},
+      tr("JSON (*.json)"));
+  if (file.isEmpty())
+    return;
 
+  if (!RenderProfiler::instance().saveTrace(file))
+  {
+    QMessageBox::warning(
+        this->context.mainWindow,
+        tr("Export render trace"),
+        tr("Could not write %1").arg(file));
+  }
 }
 
 void ApplicationPlugin::on_recenter(score::Document& doc)
@@ -254,11 +335,21 @@ void ApplicationPlugin::on_testGame()
   auto path = fi.absolutePath() + "/__gametest__" + fi.fileName();
   qDebug() << path;
 
-  QSaveFile f{path};
-  f.open(QIODevice::WriteOnly);
-  f.write(QJsonDocument{doc->saveAsJson()}.toJson());
-  f.commit();
+  // The document is serialized on a worker thread from a snapshot,
+  // so that it can keep being edited meanwhile.
+  auto& model = static_cast<const SEGMent::DocumentModel&>(doc->model().modelDelegate());
+  auto writer = new SnapshotWriter{model.snapshot(), path};
+  connect(writer, &SnapshotWriter::finished, this, [this, path] (bool ok) {
+    if(ok)
+      launchGame(path);
+    else
+      QFile::remove(path);
+  });
+  writer->start();
+}
 
+void ApplicationPlugin::launchGame(const QString& path)
+{
   auto segment_path = applicationPath();
   qDebug() << "Dir path:  " << segment_path;
 
@@ -298,6 +389,7 @@ void ApplicationPlugin::on_testGame()
 
   // Delete the temp file
   QFile::remove(path);
+  process->deleteLater();
 }
 
 void ApplicationPlugin::on_exportGame()
@@ -322,16 +414,22 @@ void ApplicationPlugin::on_exportGame()
                       dir.path() + "/macOS/game"};
 
 
+  // The same snapshot is used to save the game and to find its resources.
+  auto& m = static_cast<const SEGMent::DocumentModel&>(doc->model().modelDelegate());
+  const auto snapshot = m.snapshot();
+
   auto segment_file = doc->metadata().fileName();
   {
     QSaveFile f{segment_file};
     f.open(QIODevice::WriteOnly);
-    f.write(QJsonDocument{doc->saveAsJson()}.toJson());
+    snapshot->write(
+        f,
+        doc->context().app.applicationSettings.compactJson
+            ? QJsonDocument::Compact
+            : QJsonDocument::Indented);
     f.commit();
   }
 
-  auto& m = static_cast<const SEGMent::DocumentModel&>(doc->model().modelDelegate());
-
   const QFileInfo fi{segment_file};
   auto folder_path = fi.absolutePath();
   QFile f{segment_file};
@@ -348,29 +446,25 @@ void ApplicationPlugin::on_exportGame()
       copyRecursively(folder_path + "/Videos", target_game + "/Videos");
   }
 
-  ExportVisitor vis{[&] (const QString& path) {
-          QFileInfo fi{path};
+  for(const auto& path : snapshot->resources())
+  {
+      QFileInfo fi{path};
 
-          if(fi.isAbsolute())
+      if(fi.isAbsolute())
+      {
+          for(auto target_game : target_paths)
           {
-              for(auto target_game : target_paths)
-              {
-                  QFile::copy(path, target_game + "/" + path);
-              }
+              QFile::copy(path, target_game + "/" + path);
           }
-          else
+      }
+      else
+      {
+          for(auto target_game : target_paths)
           {
-              for(auto target_game : target_paths)
-              {
-                  QFile::copy(folder_path + "/" + path, target_game + "/" + path);
-              }
+              QFile::copy(folder_path + "/" + path, target_game + "/" + path);
           }
       }
-  };
-  for(auto& scene : m.process().scenes)
-      vis(scene);
-  for(auto& trans : m.process().transitions)
-      vis(trans);
+  }
 
   for(auto target_game : target_paths)
   {
@@ -444,25 +538,13 @@ score::GUIApplicationPlugin::GUIElements ApplicationPlugin::makeGUIElements()
   edit.menu()->addAction(m_delete_act);
   auto& h = context.menus.get().at(score::Menus::About());
   h.menu()->addAction(m_help_act);
+  auto& v = context.menus.get().at(score::Menus::View());
+  v.menu()->addSeparator();
+  v.menu()->addAction(m_showProfiler);
+  v.menu()->addAction(m_exportRenderTrace);
   return e;
 }
 
-struct SharedTransitionVisitor
-{
-  std::unordered_set<Path<SceneModel>> scenes;
-  bool operator()(const SceneToScene& t) const noexcept
-  {
-    return scenes.find(t.from) != scenes.end()
-        && scenes.find(t.to) != scenes.end();
-  }
-  template<typename T>
-  bool operator()(const T& t) const noexcept
-  {
-    return scenes.find(t.from.template splitLast<SceneModel>().first) != scenes.end()
-        && scenes.find(t.to) != scenes.end();
-  }
-};
-
 /**
  * @brief Finds all the transitions which are contained in a selection.
  *
@@ -473,23 +555,32 @@ std::vector<TransitionModel*> sharedTransitions(const Selection& sel, const SEGM
 {
   std::vector<TransitionModel*> res;
 
-  SharedTransitionVisitor vis;
-  std::unordered_set<Path<SceneModel>>& scenes = vis.scenes;
+  std::vector<const SceneModel*> scenes;
   for(auto obj : sel)
   {
     dispatch(obj.data(), [&] (auto& t) {
       using obj_t = std::remove_const_t<std::remove_reference_t<decltype(t)>>;
       if constexpr(std::is_same_v<obj_t, SceneModel>) {
-        scenes.insert(t);
+        scenes.push_back(&t);
       }
     });
   }
 
-  for(auto& trans : process.transitions)
+  // A transition is shared if it starts from a selected scene (or one of its
+  // objects) and goes to a selected scene.
+  ossia::ptr_set<const TransitionModel*> outgoing;
+  for(auto scene : scenes)
+  {
+    for(auto trans : process.outgoingTransitions(*scene))
+      outgoing.insert(trans);
+  }
+
+  for(auto scene : scenes)
   {
-    if(eggs::variants::apply(vis, trans.transition()))
+    for(auto trans : process.incomingTransitions(*scene))
     {
-      res.push_back(&trans);
+      if(outgoing.find(trans) != outgoing.end())
+        res.push_back(trans);
     }
   }
 
@@ -16,6 +16,9 @@ public:
   ApplicationPlugin(const score::GUIApplicationContext& presenter);
 
 private:
+  bool handleStartup() override;
+  //! Whether the autosaves are offered to be opened.
+  bool canOfferRecovery() const;
   void on_createdDocument(score::Document& doc) override;
   void on_documentChanged(score::Document* olddoc, score::Document* newdoc) override;
 
@@ -40,8 +43,13 @@ private:
   void on_recenter(score::Document& doc);
 
   void on_testGame();
+  //! Runs the game engine on a saved game file, then removes the file.
+  void launchGame(const QString& path);
   void on_exportGame();
 
+  void on_showProfiler(bool);
+  void on_exportRenderTrace();
+
   QAction* m_copy_act{};
   QAction* m_paste_act{};
   QAction* m_help_act{};
@@ -59,6 +67,12 @@ private:
   QAction* m_testGame{};
   QAction* m_exportGame{};
 
+  QAction* m_showProfiler{};
+  QAction* m_exportRenderTrace{};
+
+  //! The previous session crashed and is restored while starting up.
+  bool m_restoringBackups{};
+
   /*
   QAction* m_moveAction{};
   QAction* m_resizeAction{};
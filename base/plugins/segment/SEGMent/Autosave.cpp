@@ -0,0 +1,338 @@
+#include <score/application/GUIApplicationContext.hpp>
+#include <score/tools/Todo.hpp>
+
+#include <core/command/CommandStack.hpp>
+#include <core/document/Document.hpp>
+#include <core/presenter/DocumentManager.hpp>
+
+#include <ossia/detail/ptr_set.hpp>
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QMessageBox>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThreadPool>
+#include <QTimer>
+
+#include <SEGMent/Autosave.hpp>
+#include <SEGMent/Document.hpp>
+#include <SEGMent/Model/Snapshot.hpp>
+
+#include <wobjectimpl.h>
+
+namespace SEGMent
+{
+//! Hashes of the scenes and transitions of the last autosave.
+struct AutosaveHashes
+{
+  ossia::ptr_map<
+      const EntitySnapshot*,
+      std::pair<std::shared_ptr<const EntitySnapshot>, QByteArray>>
+      entities;
+};
+
+/**
+ * @brief Hashes a snapshot and writes it if it changed, from a worker thread.
+ */
+class AutosaveTask final : public QObject, public QRunnable
+{
+  W_OBJECT(AutosaveTask)
+public:
+  AutosaveTask(
+      std::shared_ptr<const DocumentSnapshot> snapshot,
+      QString path,
+      std::shared_ptr<AutosaveHashes> hashes,
+      QByteArray previousDigest,
+      int generation)
+      : m_snapshot{std::move(snapshot)}
+      , m_path{std::move(path)}
+      , m_hashes{std::move(hashes)}
+      , m_previousDigest{std::move(previousDigest)}
+      , m_generation{generation}
+  {
+    setAutoDelete(false);
+  }
+
+  void start(QThreadPool& pool)
+  {
+    // Queued: the task lives in the GUI thread.
+    connect(this, &AutosaveTask::finished, this, &QObject::deleteLater);
+    pool.start(this);
+  }
+
+  void run() override
+  {
+    const auto digest = hash();
+
+    bool ok = true;
+    if (digest != m_previousDigest)
+    {
+      QSaveFile f{m_path};
+      ok = f.open(QIODevice::WriteOnly) && m_snapshot->write(f) && f.commit();
+    }
+    finished(m_generation, digest, ok);
+  }
+
+  //! Sent from the worker thread.
+  void finished(int generation, QByteArray digest, bool ok)
+      W_SIGNAL(finished, generation, digest, ok);
+
+private:
+  QByteArray hash()
+  {
+    QCryptographicHash digest{QCryptographicHash::Sha256};
+    digest.addData(
+        QJsonDocument{m_snapshot->document}.toJson(QJsonDocument::Compact));
+
+    // The snapshots of the entities which did not change since the previous
+    // autosave are shared with it, hence their hash is already known.
+    decltype(AutosaveHashes::entities) hashes;
+    auto add = [&](const std::shared_ptr<const EntitySnapshot>& entity) {
+      QByteArray h;
+      auto it = m_hashes->entities.find(entity.get());
+      if (it != m_hashes->entities.end())
+        h = it->second.second;
+      else
+        h = QCryptographicHash::hash(
+            QJsonDocument{entity->json}.toJson(QJsonDocument::Compact),
+            QCryptographicHash::Sha256);
+
+      digest.addData(h);
+      hashes.emplace(entity.get(), std::make_pair(entity, std::move(h)));
+    };
+
+    for (const auto& scene : m_snapshot->scenes)
+      add(scene);
+    for (const auto& trans : m_snapshot->transitions)
+      add(trans);
+
+    m_hashes->entities = std::move(hashes);
+    return digest.result();
+  }
+
+  std::shared_ptr<const DocumentSnapshot> m_snapshot;
+  QString m_path;
+  std::shared_ptr<AutosaveHashes> m_hashes;
+  QByteArray m_previousDigest;
+  int m_generation{};
+};
+
+namespace
+{
+const QString autosavePrefix = QStringLiteral("__autosave__");
+
+//! Removes a file after the operations requested before on it.
+class AutosaveRemoval final : public QRunnable
+{
+public:
+  explicit AutosaveRemoval(QString path) : m_path{std::move(path)} {}
+
+  void run() override { QFile::remove(m_path); }
+
+private:
+  QString m_path;
+};
+
+QString appDataPath()
+{
+  return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+}
+}
+
+Autosave::Autosave(
+    score::Document& doc,
+    const DocumentModel& model,
+    QObject* parent)
+    : QObject{parent}
+    , m_document{doc}
+    , m_model{model}
+    , m_hashes{std::make_shared<AutosaveHashes>()}
+{
+  m_io.setMaxThreadCount(1);
+
+  auto& stack = doc.commandStack();
+  con(stack, &score::CommandStack::stackChanged, this, [this] {
+    m_dirty = true;
+  });
+  con(stack,
+      &score::CommandStack::savedIndexChanged,
+      this,
+      &Autosave::on_savedIndexChanged);
+
+  connect(&m_timer, &QTimer::timeout, this, &Autosave::save);
+  m_timer.start(interval);
+}
+
+Autosave::~Autosave()
+{
+  removeFile();
+  m_io.waitForDone();
+}
+
+QString Autosave::autosavePath(const QString& documentPath)
+{
+  QFileInfo fi{documentPath};
+  const auto folder = fi.isAbsolute() ? fi.absolutePath() : appDataPath();
+  return folder + "/" + autosavePrefix + fi.fileName();
+}
+
+QString Autosave::documentPath(const QString& autosavePath)
+{
+  QFileInfo fi{autosavePath};
+  return fi.absolutePath() + "/" + fi.fileName().mid(autosavePrefix.size());
+}
+
+void Autosave::offerRecovery(
+    const score::GUIApplicationContext& ctx,
+    score::Document& doc)
+{
+  const auto file = doc.metadata().fileName();
+  const QFileInfo autosave{autosavePath(file)};
+  if (!autosave.exists()
+      || autosave.lastModified() <= QFileInfo{file}.lastModified())
+    return;
+
+  // Asked once the document is shown
+  const auto path = autosave.absoluteFilePath();
+  QTimer::singleShot(0, &doc, [&ctx, &doc, path] {
+    const auto res = QMessageBox::question(
+        ctx.mainWindow,
+        QObject::tr("Autosave"),
+        QObject::tr("%1 has an autosave more recent than the file.\n"
+                    "Open the autosave? Otherwise it is deleted.")
+            .arg(QFileInfo{doc.metadata().fileName()}.fileName()));
+
+    if (res == QMessageBox::Yes)
+    {
+      // Closing the document ends this call's context
+      const auto autosave_path = path;
+      ctx.docManager.forceCloseDocument(ctx, doc);
+      openAutosave(ctx, autosave_path);
+    }
+    else
+    {
+      QFile::remove(path);
+    }
+  });
+}
+
+void Autosave::offerRecovery(const score::GUIApplicationContext& ctx)
+{
+  // The documents which were never saved are kept in the application data
+  // folder, see autosavePath.
+  const QDir appData{appDataPath()};
+  QStringList autosaves;
+  for (const auto& fi :
+       appData.entryInfoList({autosavePrefix + "*"}, QDir::Files))
+    autosaves.push_back(fi.absoluteFilePath());
+
+  if (autosaves.empty())
+    return;
+
+  const auto res = QMessageBox::question(
+      ctx.mainWindow,
+      QObject::tr("Autosave"),
+      QObject::tr("%n document(s) which were never saved have an autosave.\n"
+                  "Open them? Otherwise they are deleted.",
+                  "",
+                  autosaves.size()));
+
+  for (const auto& path : autosaves)
+  {
+    if (res == QMessageBox::Yes)
+      openAutosave(ctx, path);
+    else
+      QFile::remove(path);
+  }
+}
+
+void Autosave::openAutosave(
+    const score::GUIApplicationContext& ctx,
+    const QString& path)
+{
+  // The autosave is removed below, hence it is not a recent file
+  auto doc = ctx.docManager.loadFile(ctx, path, false);
+  if (!doc)
+    return;
+
+  // The document keeps its own file, in which it is not saved yet. Its
+  // content is now in memory, and autosaved again at the next interval.
+  doc->metadata().setFileName(documentPath(path));
+  doc->commandStack().markAsUnsaved();
+  QFile::remove(path);
+}
+
+void Autosave::save()
+{
+  if (m_saving || !m_dirty)
+    return;
+  m_dirty = false;
+
+  // The document file is up-to-date
+  if (m_document.commandStack().isAtSavedIndex())
+  {
+    removeFile();
+    return;
+  }
+
+  const auto path = autosavePath(m_document.metadata().fileName());
+  if (path != m_path)
+  {
+    removeFile();
+    m_path = path;
+
+    // e.g. the application data folder
+    QDir{}.mkpath(QFileInfo{m_path}.absolutePath());
+  }
+
+  m_saving = true;
+  auto task = new AutosaveTask{
+      m_model.snapshot(), m_path, m_hashes, m_digest, m_generation};
+  connect(task, &AutosaveTask::finished, this, &Autosave::on_saved);
+  task->start(m_io);
+}
+
+void Autosave::on_saved(int generation, const QByteArray& digest, bool ok)
+{
+  m_saving = false;
+
+  // The file was removed since
+  if (generation != m_generation)
+    return;
+
+  if (ok)
+    m_digest = digest;
+  else
+    m_dirty = true;
+}
+
+void Autosave::on_savedIndexChanged()
+{
+  // The autosave of the previous state is stale once the document is saved
+  if (m_document.commandStack().isAtSavedIndex())
+    removeFile();
+  else
+    m_dirty = true;
+}
+
+void Autosave::removeFile()
+{
+  if (m_path.isEmpty())
+    return;
+
+  // After the write in progress, if any
+  m_io.start(new AutosaveRemoval{m_path});
+  m_path.clear();
+  m_digest.clear();
+  m_generation++;
+}
+} // namespace SEGMent
+
+W_OBJECT_IMPL(SEGMent::AutosaveTask)
+W_OBJECT_IMPL(SEGMent::Autosave)
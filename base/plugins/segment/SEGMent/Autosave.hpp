@@ -0,0 +1,90 @@
+#pragma once
+#include <QByteArray>
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+#include <QTimer>
+
+#include <verdigris>
+
+#include <memory>
+
+namespace score
+{
+class Document;
+struct GUIApplicationContext;
+}
+namespace SEGMent
+{
+class DocumentModel;
+struct AutosaveHashes;
+
+/**
+ * @brief Periodically saves a copy of a document next to it.
+ *
+ * A save only happens if the command stack changed since the previous one
+ * and the document is not at its saved state.
+ * The snapshot is taken on the GUI thread, which only serializes the scenes
+ * and transitions edited since the previous snapshot. Hashing and writing
+ * happen in a thread owned by the autosave, which also removes the copy:
+ * the operations on the file happen one after the other, in the order
+ * they were requested. Nothing is written if the content did not change,
+ * e.g. after undoing the edits.
+ *
+ * The copy is removed when the document is saved or closed.
+ */
+class Autosave final : public QObject
+{
+  W_OBJECT(Autosave)
+public:
+  Autosave(score::Document& doc, const DocumentModel& model, QObject* parent);
+  ~Autosave() override;
+
+  static constexpr int interval = 30000;
+
+  //! e.g. foo/bar.segment -> foo/__autosave__bar.segment.
+  //! Documents without a folder, e.g. "Untitled", are autosaved in the
+  //! application data folder.
+  static QString autosavePath(const QString& documentPath);
+
+  //! e.g. foo/__autosave__bar.segment -> foo/bar.segment
+  static QString documentPath(const QString& autosavePath);
+
+  //! Offers to open the autosave of a document instead of it, if there is
+  //! one more recent than its file.
+  static void
+  offerRecovery(const score::GUIApplicationContext& ctx, score::Document& doc);
+
+  //! Offers to open the autosaves of the documents which were never saved
+  //! by the user, left in the application data folder.
+  static void offerRecovery(const score::GUIApplicationContext& ctx);
+
+  void save();
+
+private:
+  //! Opens an autosave as the document it was saved from.
+  static void
+  openAutosave(const score::GUIApplicationContext& ctx, const QString& path);
+
+  void on_saved(int generation, const QByteArray& digest, bool ok);
+  void on_savedIndexChanged();
+  void removeFile();
+
+  score::Document& m_document;
+  const DocumentModel& m_model;
+  QTimer m_timer;
+
+  QString m_path;
+  QByteArray m_digest;
+  std::shared_ptr<AutosaveHashes> m_hashes;
+
+  //! Incremented when the file is removed: the saves which were in
+  //! progress then do not describe the file any more.
+  int m_generation{};
+  bool m_dirty{};
+  bool m_saving{};
+
+  //! Writes and removes the file, one operation at a time.
+  QThreadPool m_io;
+};
+} // namespace SEGMent
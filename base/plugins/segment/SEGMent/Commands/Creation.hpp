@@ -122,6 +122,95 @@ private:
   QJsonObject m_json{};
 };
 
+/**
+ * @brief Command used when an user pastes scenes and the transitions between them.
+ *
+ * The scenes, then the transitions, are added in a single batch each,
+ * so that the view is only laid out once whatever the size of the paste.
+ */
+class PasteSceneGroup final : public score::Command
+{
+  SCORE_COMMAND_DECL(CommandFactoryName(), PasteSceneGroup, "Paste scenes")
+public:
+  PasteSceneGroup(
+      const ProcessModel& process,
+      std::vector<Id<SceneModel>> sceneIds,
+      std::vector<QJsonObject> scenes,
+      std::vector<QJsonObject> transitions)
+      : m_path{process}
+      , m_sceneIds{std::move(sceneIds)}
+      , m_scenes{std::move(scenes)}
+      , m_transitions{std::move(transitions)}
+  {
+    SCORE_ASSERT(m_sceneIds.size() == m_scenes.size());
+
+    auto next_id = getStrongId(process.transitions).val();
+    m_transitionIds.reserve(m_transitions.size());
+    for (std::size_t i = 0; i < m_transitions.size(); i++)
+      m_transitionIds.push_back(Id<TransitionModel>{next_id++});
+  }
+
+  void undo(const score::DocumentContext& ctx) const override
+  {
+    auto& process = m_path.find(ctx);
+    for (const auto& id : m_transitionIds)
+      process.transitions.remove(id);
+    for (const auto& id : m_sceneIds)
+      process.scenes.remove(id);
+  }
+
+  void redo(const score::DocumentContext& ctx) const override
+  {
+    auto& process = m_path.find(ctx);
+    const bool wasEmpty = process.scenes.empty();
+
+    std::vector<SceneModel*> scenes;
+    scenes.reserve(m_scenes.size());
+    for (std::size_t i = 0; i < m_scenes.size(); i++)
+    {
+      auto scene = new SceneModel{JSONObjectWriter{m_scenes[i]}, &process};
+      scene->setId(m_sceneIds[i]);
+      scenes.push_back(scene);
+    }
+
+    // If these are the first scenes to be pasted, we set one as initial.
+    // Else some users are lost :-)
+    if (wasEmpty && !scenes.empty())
+    {
+      scenes.front()->setSceneType(SceneModel::Initial);
+    }
+    process.scenes.add_range(scenes);
+
+    std::vector<TransitionModel*> transitions;
+    transitions.reserve(m_transitions.size());
+    for (std::size_t i = 0; i < m_transitions.size(); i++)
+    {
+      auto transition
+          = new TransitionModel{JSONObjectWriter{m_transitions[i]}, &process};
+      transition->setId(m_transitionIds[i]);
+      transitions.push_back(transition);
+    }
+    process.transitions.add_range(transitions);
+  }
+
+protected:
+  void serializeImpl(DataStreamInput& s) const override
+  {
+    s << m_path << m_sceneIds << m_scenes << m_transitionIds << m_transitions;
+  }
+  void deserializeImpl(DataStreamOutput& s) override
+  {
+    s >> m_path >> m_sceneIds >> m_scenes >> m_transitionIds >> m_transitions;
+  }
+
+private:
+  Path<ProcessModel> m_path;
+  std::vector<Id<SceneModel>> m_sceneIds;
+  std::vector<QJsonObject> m_scenes;
+  std::vector<Id<TransitionModel>> m_transitionIds;
+  std::vector<QJsonObject> m_transitions;
+};
+
 class PasteScenes final : public score::AggregateCommand
 {
   SCORE_COMMAND_DECL(CommandFactoryName(), PasteScenes, "Paste scenes")
@@ -176,7 +265,7 @@ public:
   {
     auto& scene = m_path.find(ctx);
     auto obj = new T{JSONObjectWriter{m_json}, &scene};
-    obj->setId(getStrongId(SceneAccessor<T>::get(scene)));
+    obj->setId(m_newId);
     SceneAccessor<T>::get(scene).add(obj);
   }
 
@@ -249,7 +338,7 @@ class DropImage final : public score::Command
 public:
   DropImage(const SceneModel& obj, Image image, QPointF pos, QSizeF size)
       : m_path{obj}
-      , m_newId{getStrongId(obj.objects)}
+      , m_newId{getStrongId(obj.objects())}
       , m_image{image}
       , m_pos{pos}
       , m_size{size}
@@ -259,7 +348,7 @@ public:
   void undo(const score::DocumentContext& ctx) const override
   {
     auto& scene = m_path.find(ctx);
-    scene.objects.remove(m_newId);
+    scene.objects().remove(m_newId);
   }
 
   void redo(const score::DocumentContext& ctx) const override
@@ -269,7 +358,7 @@ public:
     obj->setImage(m_image);
     obj->setPos(m_pos);
     obj->setSize(m_size);
-    scene.objects.add(obj);
+    scene.objects().add(obj);
   }
 
 protected:
@@ -297,7 +386,7 @@ class DropGif final : public score::Command
 public:
   DropGif(const SceneModel& obj, Image image, QPointF pos, QSizeF sz)
       : m_path{obj}
-      , m_newId{getStrongId(obj.gifs)}
+      , m_newId{getStrongId(obj.gifs())}
       , m_image{image}
       , m_pos{pos}
       , m_size{sz}
@@ -307,7 +396,7 @@ public:
   void undo(const score::DocumentContext& ctx) const override
   {
     auto& scene = m_path.find(ctx);
-    scene.gifs.remove(m_newId);
+    scene.gifs().remove(m_newId);
   }
 
   void redo(const score::DocumentContext& ctx) const override
@@ -317,7 +406,7 @@ public:
     obj->setImage(m_image);
     obj->setPos(m_pos);
     obj->setSize(m_size);
-    scene.gifs.add(obj);
+    scene.gifs().add(obj);
   }
 
 protected:
@@ -345,7 +434,7 @@ class DropClickArea final : public score::Command
 public:
   DropClickArea(const SceneModel& scene, QPointF pos, QSizeF sz)
       : m_path{scene}
-      , m_newId{getStrongId(scene.clickAreas)}
+      , m_newId{getStrongId(scene.clickAreas())}
       , m_pos{pos}
       , m_size{sz}
   {
@@ -354,7 +443,7 @@ public:
   void undo(const score::DocumentContext& ctx) const override
   {
     auto& scene = m_path.find(ctx);
-    scene.clickAreas.remove(m_newId);
+    scene.clickAreas().remove(m_newId);
   }
 
   void redo(const score::DocumentContext& ctx) const override
@@ -363,7 +452,7 @@ public:
     auto obj = new ClickAreaModel{m_newId, &scene};
     obj->setPos(m_pos);
     obj->setSize(m_size);
-    scene.clickAreas.add(obj);
+    scene.clickAreas().add(obj);
   }
 
 protected:
@@ -393,7 +482,7 @@ class DropBackClickArea final : public score::Command
 public:
   DropBackClickArea(const SceneModel& scene, QPointF pos, QSizeF sz)
       : m_path{scene}
-      , m_newId{getStrongId(scene.backClickAreas)}
+      , m_newId{getStrongId(scene.backClickAreas())}
       , m_pos{pos}
       , m_size{sz}
   {
@@ -402,7 +491,7 @@ public:
   void undo(const score::DocumentContext& ctx) const override
   {
     auto& scene = m_path.find(ctx);
-    scene.backClickAreas.remove(m_newId);
+    scene.backClickAreas().remove(m_newId);
   }
 
   void redo(const score::DocumentContext& ctx) const override
@@ -411,7 +500,7 @@ public:
     auto obj = new BackClickAreaModel{m_newId, &scene};
     obj->setPos(m_pos);
     obj->setSize(m_size);
-    scene.backClickAreas.add(obj);
+    scene.backClickAreas().add(obj);
   }
 
 protected:
@@ -438,7 +527,7 @@ class DropTextArea final : public score::Command
 public:
   DropTextArea(const SceneModel& scene, QPointF pos, QSizeF sz)
       : m_path{scene}
-      , m_newId{getStrongId(scene.textAreas)}
+      , m_newId{getStrongId(scene.textAreas())}
       , m_pos{pos}
       , m_size{sz}
   {
@@ -447,7 +536,7 @@ public:
   void undo(const score::DocumentContext& ctx) const override
   {
     auto& scene = m_path.find(ctx);
-    scene.textAreas.remove(m_newId);
+    scene.textAreas().remove(m_newId);
   }
 
   void redo(const score::DocumentContext& ctx) const override
@@ -456,7 +545,7 @@ public:
     auto obj = new TextAreaModel{m_newId, &scene};
     obj->setPos(m_pos);
     obj->setSize(m_size);
-    scene.textAreas.add(obj);
+    scene.textAreas().add(obj);
   }
 
 protected:
@@ -206,51 +206,35 @@ struct RemoveObjectVisitor
   MacroCommandDispatcher<RemoveObjects>& dispatcher;
   std::unordered_map<Id<TransitionModel>, score::Command*> transitions;
   std::vector<score::Command*> others;
+
+  void removeTransition(const ProcessModel& proc, const TransitionModel& trans)
+  {
+      if(transitions.find(trans.id()) == transitions.end())
+          transitions[trans.id()] = new RemoveTransition{proc, trans};
+  }
+
   void operator()(const SceneModel& sc)
   {
       auto& proc = *static_cast<ProcessModel*>(sc.parent());
-      auto sc_path = score::IDocument::path(sc);
-      for (auto& trans : proc.transitions)
-      {
-        eggs::variants::apply(
-            [&](const auto& transition) {
-              if (is_parent(sc_path, transition.from)
-                  || is_parent(sc_path, transition.to))
-              {
-                  if(transitions.find(trans.id()) == transitions.end())
-                      transitions[trans.id()] = new RemoveTransition{proc, trans};
-              }
-            },
-            trans.transition());
-      }
+      for (auto trans : proc.incomingTransitions(sc))
+          removeTransition(proc, *trans);
+      for (auto trans : proc.outgoingTransitions(sc))
+          removeTransition(proc, *trans);
 
       others.push_back(new RemoveScene{proc, sc});
   }
   void operator()(const TransitionModel& trans)
   {
       auto& proc = *static_cast<ProcessModel*>(trans.parent());
-      if(transitions.find(trans.id()) == transitions.end())
-          transitions[trans.id()] = new RemoveTransition{proc, trans};
+      removeTransition(proc, trans);
   }
   template <typename T>
   void operator()(const T& obj)
   {
     auto& scene = *static_cast<SceneModel*>(obj.parent());
     auto& proc = (SEGMent::ProcessModel&)*scene.parent();
-    auto obj_path = score::IDocument::path(obj);
-    for (auto& trans : proc.transitions)
-    {
-      eggs::variants::apply(
-          [&](const auto& transition) {
-            if (is_parent(obj_path, transition.from)
-                || is_parent(obj_path, transition.to))
-            {
-                if(transitions.find(trans.id()) == transitions.end())
-                    transitions[trans.id()] = new RemoveTransition{proc, trans};
-            }
-          },
-          trans.transition());
-    }
+    for (auto trans : proc.outgoingTransitions(obj))
+      removeTransition(proc, *trans);
     others.push_back(new RemoveObject{scene, obj});
   }
 
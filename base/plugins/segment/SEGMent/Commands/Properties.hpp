@@ -25,6 +25,93 @@ class MoveSceneRects : public score::AggregateCommand
   SCORE_COMMAND_DECL(CommandFactoryName(), MoveSceneRects, "Move scenes")
 };
 
+/**
+ * @brief Moves and resizes a group of scenes with a single transform.
+ *
+ * The scenes and their initial rects are stored once: updating the command
+ * while dragging only changes the translation and the scale, which are
+ * applied to each scene from its own top-left corner.
+ */
+class TransformScenes final : public score::Command
+{
+  SCORE_COMMAND_DECL(CommandFactoryName(), TransformScenes, "Move scenes")
+public:
+  TransformScenes(
+      const ProcessModel& process,
+      const std::vector<const SceneModel*>& scenes,
+      QPointF translation,
+      qreal scale)
+      : m_path{process}, m_translation{translation}, m_scale{scale}
+  {
+    m_scenes.reserve(scenes.size());
+    m_rects.reserve(scenes.size());
+    for (auto scene : scenes)
+    {
+      m_scenes.push_back(scene->id());
+      m_rects.push_back(scene->rect());
+    }
+  }
+
+  void update(
+      const ProcessModel&,
+      const std::vector<const SceneModel*>&,
+      QPointF translation,
+      qreal scale)
+  {
+    m_translation = translation;
+    m_scale = scale;
+  }
+
+  void undo(const score::DocumentContext& ctx) const override
+  {
+    auto& process = m_path.find(ctx);
+    for (std::size_t i = 0; i < m_scenes.size(); i++)
+    {
+      process.scenes.at(m_scenes[i]).setRect(m_rects[i]);
+    }
+  }
+
+  void redo(const score::DocumentContext& ctx) const override
+  {
+    auto& process = m_path.find(ctx);
+    for (std::size_t i = 0; i < m_scenes.size(); i++)
+    {
+      process.scenes.at(m_scenes[i]).setRect(transformed(m_rects[i]));
+    }
+  }
+
+protected:
+  QRectF transformed(const QRectF& r) const noexcept
+  {
+    return {qBound(
+                -maxSceneCoordinate,
+                r.x() + m_translation.x(),
+                maxSceneCoordinate),
+            qBound(
+                -maxSceneCoordinate,
+                r.y() + m_translation.y(),
+                maxSceneCoordinate),
+            r.width() * m_scale,
+            r.height() * m_scale};
+  }
+
+  void serializeImpl(DataStreamInput& s) const override
+  {
+    s << m_path << m_scenes << m_rects << m_translation << m_scale;
+  }
+  void deserializeImpl(DataStreamOutput& s) override
+  {
+    s >> m_path >> m_scenes >> m_rects >> m_translation >> m_scale;
+  }
+
+private:
+  Path<ProcessModel> m_path;
+  std::vector<Id<SceneModel>> m_scenes;
+  std::vector<QRectF> m_rects;
+  QPointF m_translation{};
+  qreal m_scale{1.};
+};
+
 class ChangeRiddle : public score::Command
 {
   SCORE_COMMAND_DECL(CommandFactoryName(), ChangeRiddle, "Change a riddle")
@@ -48,6 +135,19 @@ public:
     setRiddle(m_new, ctx);
   }
 
+  bool mergeWith(const score::Command& other) override
+  {
+    if (other.key() != key() || other.parentKey() != parentKey())
+      return false;
+
+    const auto& cmd = static_cast<const ChangeRiddle&>(other);
+    if (!(cmd.m_path == m_path))
+      return false;
+
+    m_new = cmd.m_new;
+    return true;
+  }
+
 protected:
   void setRiddle(const riddle_t& r, const score::DocumentContext& ctx) const
   {
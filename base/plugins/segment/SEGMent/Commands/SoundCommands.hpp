@@ -64,6 +64,19 @@ public:
     ((const_cast<T&>(obj).*Sound)()).setVolume(m_new);
   }
 
+  bool mergeWith(const score::Command& other) override
+  {
+    if (other.key() != key() || other.parentKey() != parentKey())
+      return false;
+
+    const auto& cmd = static_cast<const SetVolume&>(other);
+    if (!(cmd.m_model == m_model))
+      return false;
+
+    m_new = cmd.m_new;
+    return true;
+  }
+
   void serializeImpl(DataStreamInput& s) const override
   {
     s << m_model << m_old << m_new;
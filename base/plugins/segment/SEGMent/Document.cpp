@@ -1,4 +1,8 @@
-﻿#include <score/tools/IdentifierGeneration.hpp>
+﻿#include <score/serialization/BinaryDocument.hpp>
+#include <score/serialization/JSONStreamReader.hpp>
+#include <score/serialization/JSONStreamWriter.hpp>
+#include <score/serialization/JSONVisitor.hpp>
+#include <score/tools/IdentifierGeneration.hpp>
 
 #include <core/document/Document.hpp>
 #include <core/document/DocumentModel.hpp>
@@ -6,14 +10,24 @@
 #include <QJsonDocument>
 #include <QMessageBox>
 #include <QOpenGLWidget>
+#include <QRunnable>
 #include <QSaveFile>
 #include <QScrollBar>
+#include <QSemaphore>
+#include <QThreadPool>
 #include <QWheelEvent>
 
 #include <SEGMent/Commands/Creation.hpp>
 #include <SEGMent/Document.hpp>
 #include <SEGMent/Model/Layer/ProcessPresenter.hpp>
 #include <SEGMent/Model/Layer/ProcessView.hpp>
+#include <SEGMent/Model/ProcessModel.hpp>
+#include <SEGMent/Model/Snapshot.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <stdexcept>
 namespace SEGMent
 {
 DocumentModel::DocumentModel(
@@ -43,7 +57,7 @@ DocumentModel::DocumentModel(
   QTimer::singleShot(0, [=] {
     QSaveFile f{savename};
     f.open(QIODevice::WriteOnly);
-    f.write(QJsonDocument{m_context.document.saveAsJson()}.toJson());
+    m_context.document.saveAsJson(f);
     f.commit();
   });
 }
@@ -53,6 +67,15 @@ SEGMent::ProcessModel& DocumentModel::process() const
   return *m_base;
 }
 
+std::shared_ptr<const DocumentSnapshot> DocumentModel::snapshot() const
+{
+  // Created on first use: the first snapshot serializes everything,
+  // the following ones only what changed since.
+  if (!m_snapshots)
+    m_snapshots = std::make_unique<SnapshotBuilder>(m_context.document, *m_base);
+  return m_snapshots->snapshot();
+}
+
 DocumentModel::~DocumentModel() {}
 
 void DocumentModel::serialize(const VisitorVariant& vis) const
@@ -60,6 +83,35 @@ void DocumentModel::serialize(const VisitorVariant& vis) const
   serialize_dyn(vis, *this);
 }
 
+void DocumentModel::serializeJson(JSONStreamWriter& writer) const
+{
+  // Same object as the JSONObjectReader. The snapshot only serializes the
+  // scenes and transitions which changed since the previous save or
+  // snapshot, and the text of the others is reused.
+  snapshot()->writeDocument(writer);
+}
+
+QJsonObject DocumentModel::serializeBinary(
+    BinaryDocumentWriter& writer,
+    const QString& path) const
+{
+  // Same object as the JSONObjectReader, but the scenes and transitions
+  // are sections of the binary document, so that they can be read
+  // individually. Those which did not change since the previous save or
+  // snapshot are not serialized again.
+  const auto snap = snapshot();
+
+  auto entities = [&](const QString& section, const auto& snapshots) {
+    writer.addSection(section);
+    for (const auto& entity : snapshots)
+      writer.addEntry(section, entity->json);
+  };
+  entities(path + "/Process/Scenes", snap->scenes);
+  entities(path + "/Process/Transitions", snap->transitions);
+
+  return snap->document["Document"].toObject();
+}
+
 void DocumentModel::savedDocumentAs(const QString& origPath, const QString& newPath)
 {
   auto origDir = QFileInfo{origPath}.absoluteDir();
@@ -197,6 +249,289 @@ void DocumentFactory::load(
   });
 }
 
+namespace
+{
+/**
+ * @brief A scene or transition decoded from its save data.
+ *
+ * Decoding does not create any QObject, so that it can run on the thread
+ * pool: only the creation of the models is left to the GUI thread.
+ * It stops at the JSON object, which the models are then built from by
+ * their usual deserializers.
+ */
+struct DecodedEntity
+{
+  QJsonObject obj;
+
+  //! For scenes, their objects, which are created when they are needed.
+  QJsonObject children;
+
+  QString error;
+};
+
+template <typename T>
+void decodeEntity(DecodedEntity&)
+{
+}
+
+template <>
+void decodeEntity<SceneModel>(DecodedEntity& e)
+{
+  e.children = SceneModel::takeChildren(e.obj);
+}
+
+template <typename T>
+T* createEntity(DecodedEntity& e, ProcessModel& proc)
+{
+  return new T{JSONObject::Deserializer{e.obj}, &proc};
+}
+
+template <>
+SceneModel* createEntity<SceneModel>(DecodedEntity& e, ProcessModel& proc)
+{
+  return SceneModel::loadLazily(e.obj, std::move(e.children), &proc);
+}
+
+/**
+ * @brief Calls decode(i) for each i in [0, n).
+ *
+ * The indices are taken by chunks by the calling thread and by the
+ * threads of the global pool which are available. Returns once they are
+ * all decoded; decode must not throw.
+ */
+template <typename F>
+void decodeInParallel(int n, const F& decode)
+{
+  constexpr int chunkSize = 8;
+  const int chunks = (n + chunkSize - 1) / chunkSize;
+
+  std::atomic_int next{0};
+  const std::function<void()> work = [&] {
+    for (int c = next++; c < chunks; c = next++)
+    {
+      const int end = std::min(n, (c + 1) * chunkSize);
+      for (int i = c * chunkSize; i < end; i++)
+        decode(i);
+    }
+  };
+
+  class Worker final : public QRunnable
+  {
+  public:
+    Worker(const std::function<void()>& work, QSemaphore& done)
+        : m_work{work}, m_done{done}
+    {
+    }
+
+    void run() override
+    {
+      m_work();
+      m_done.release();
+    }
+
+  private:
+    const std::function<void()>& m_work;
+    QSemaphore& m_done;
+  };
+
+  // Threads busy with other tasks, e.g. writing a snapshot, are not
+  // waited for: this thread decodes whatever is left.
+  QSemaphore done;
+  int started = 0;
+  auto pool = QThreadPool::globalInstance();
+  for (int t = 1; t < chunks && t < pool->maxThreadCount(); t++)
+  {
+    auto worker = new Worker{work, done};
+    if (!pool->tryStart(worker))
+    {
+      delete worker;
+      break;
+    }
+    started++;
+  }
+
+  work();
+  done.acquire(started);
+}
+
+//! Creates the decoded scenes or transitions, in their order in the file.
+template <typename T>
+void createEntities(
+    std::vector<DecodedEntity>& decoded,
+    ProcessModel& proc,
+    score::EntityMap<T>& map)
+{
+  for (const auto& e : decoded)
+  {
+    if (!e.error.isEmpty())
+      throw std::runtime_error(e.error.toStdString());
+  }
+
+  // Each element is released once its model exists, so that the save data
+  // and the models of the whole array are not in memory at the same time.
+  std::vector<T*> res;
+  res.reserve(decoded.size());
+  for (auto& e : decoded)
+  {
+    res.push_back(createEntity<T>(e, proc));
+    e = DecodedEntity{};
+  }
+  map.add_range(res);
+}
+
+//! Loads the scenes or transitions of an array: the text of each element
+//! is found by the pull parser, then parsed on the thread pool.
+template <typename T>
+void loadEntities(
+    const QByteArray& text,
+    ProcessModel& proc,
+    score::EntityMap<T>& map)
+{
+  if (text.isEmpty())
+    return;
+
+  JSONStreamReader reader{text};
+  std::vector<QByteArray> elements;
+  if (reader.next() == JSONStreamReader::BeginArray)
+  {
+    while (reader.hasNext())
+      elements.push_back(reader.rawValue());
+  }
+
+  if (reader.hasError())
+    throw std::runtime_error(reader.errorString().toStdString());
+
+  std::vector<DecodedEntity> decoded(elements.size());
+  decodeInParallel(int(elements.size()), [&](int i) {
+    auto& e = decoded[i];
+    QJsonParseError err;
+    const auto doc = QJsonDocument::fromJson(elements[i], &err);
+    if (err.error != QJsonParseError::NoError)
+    {
+      e.error = QStringLiteral("Element %1: %2").arg(i).arg(err.errorString());
+      return;
+    }
+    if (!doc.isObject())
+    {
+      e.error = QStringLiteral("Element %1 is not an object").arg(i);
+      return;
+    }
+
+    e.obj = doc.object();
+    decodeEntity<T>(e);
+  });
+
+  createEntities(decoded, proc, map);
+}
+
+//! Loads the scenes or transitions of a section, decoded on the thread
+//! pool straight from the mapped file.
+template <typename T>
+void loadEntities(
+    const BinaryDocumentReader& reader,
+    const QString& section,
+    ProcessModel& proc,
+    score::EntityMap<T>& map)
+{
+  const int n = reader.entryCount(section);
+  std::vector<DecodedEntity> decoded(n);
+  decodeInParallel(n, [&](int i) {
+    auto& e = decoded[i];
+    const auto v = reader.entry(section, i);
+    if (!v.isObject())
+    {
+      e.error = QStringLiteral("Element %1 of %2 is not an object")
+                    .arg(i)
+                    .arg(section);
+      return;
+    }
+
+    e.obj = v.toObject();
+    decodeEntity<T>(e);
+  });
+
+  if (reader.hasError())
+    throw std::runtime_error(reader.errorString().toStdString());
+
+  createEntities(decoded, proc, map);
+}
+} // namespace
+
+void DocumentFactory::loadJson(
+    JSONStreamReader& reader,
+    const score::DocumentContext& ctx,
+    score::DocumentDelegateModel*& ptr,
+    score::DocumentModel* parent)
+{
+  // The document and the process are first read without their scenes and
+  // transitions, whose elements are then parsed in parallel.
+  QJsonObject doc, process;
+  QByteArray scenes, transitions;
+  if (reader.next() == JSONStreamReader::BeginObject)
+  {
+    while (reader.hasNext())
+    {
+      reader.next();
+      const auto key = reader.key();
+      if (key != "Process")
+      {
+        doc[key] = reader.readValue();
+        continue;
+      }
+
+      if (reader.next() != JSONStreamReader::BeginObject)
+        break;
+      while (reader.hasNext())
+      {
+        reader.next();
+        const auto member = reader.key();
+        if (member == "Scenes")
+          scenes = reader.rawValue();
+        else if (member == "Transitions")
+          transitions = reader.rawValue();
+        else
+          process[member] = reader.readValue();
+      }
+      reader.next();
+    }
+  }
+
+  if (reader.hasError())
+    throw std::runtime_error(reader.errorString().toStdString());
+  doc["Process"] = process;
+
+  std::allocator<DocumentModel> alloc;
+  auto res = alloc.allocate(1);
+  ptr = res;
+  JSONObject::Deserializer des{doc};
+  alloc.construct(res, des, ctx, parent);
+
+  // Same order as JSONObjectWriter::write(ProcessModel&)
+  auto& proc = res->process();
+  loadEntities(scenes, proc, proc.scenes);
+  loadEntities(transitions, proc, proc.transitions);
+}
+
+void DocumentFactory::loadBinary(
+    const BinaryDocumentReader& reader,
+    const QString& path,
+    const score::DocumentContext& ctx,
+    score::DocumentDelegateModel*& ptr,
+    score::DocumentModel* parent)
+{
+  // The header has the document and the process without their scenes and
+  // transitions, which are decoded in parallel from the mapped file.
+  std::allocator<DocumentModel> alloc;
+  auto res = alloc.allocate(1);
+  ptr = res;
+  JSONObject::Deserializer des{reader.header()[path].toObject()};
+  alloc.construct(res, des, ctx, parent);
+
+  auto& proc = res->process();
+  loadEntities(reader, path + "/Process/Scenes", proc, proc.scenes);
+  loadEntities(reader, path + "/Process/Transitions", proc, proc.transitions);
+}
+
 } // namespace SEGMent
 
 W_OBJECT_IMPL(SEGMent::DocumentModel)
@@ -10,11 +10,15 @@
 #include <SEGMent/Items/SceneWindow.hpp>
 #include <nano_observer.hpp>
 
+#include <memory>
+
 namespace SEGMent
 {
 class ProcessModel;
 class ZoomView;
 class Presenter;
+class SnapshotBuilder;
+struct DocumentSnapshot;
 
 //! The base data model for a SEGMent document.
 class DocumentModel final : public score::DocumentDelegateModel,
@@ -26,6 +30,11 @@ public:
   DocumentModel(const score::DocumentContext& ctx, QObject* parent);
 
   SEGMent::ProcessModel& process() const;
+
+  //! Immutable copy of the document which can be read from worker threads.
+  //! Must be called from the GUI thread.
+  std::shared_ptr<const DocumentSnapshot> snapshot() const;
+
   template <typename Impl>
   DocumentModel(Impl& vis, const score::DocumentContext& ctx, QObject* parent)
       : score::DocumentDelegateModel{vis, parent}, m_context{ctx}
@@ -36,11 +45,16 @@ public:
   ~DocumentModel() override;
 
   void serialize(const VisitorVariant& vis) const override;
+  void serializeJson(JSONStreamWriter& writer) const override;
+  QJsonObject serializeBinary(
+      BinaryDocumentWriter& writer,
+      const QString& path) const override;
   void savedDocumentAs(const QString& oldpath, const QString& newpath) override;
 
 private:
   const score::DocumentContext& m_context;
   SEGMent::ProcessModel* m_base{};
+  mutable std::unique_ptr<SnapshotBuilder> m_snapshots;
 };
 
 //! Displays a SEGMent document
@@ -106,6 +120,19 @@ class DocumentFactory final : public score::DocumentDelegateFactory
       const score::DocumentContext& ctx,
       score::DocumentDelegateModel*& ptr,
       score::DocumentModel* parent) override;
+
+  void loadJson(
+      JSONStreamReader& reader,
+      const score::DocumentContext& ctx,
+      score::DocumentDelegateModel*& ptr,
+      score::DocumentModel* parent) override;
+
+  void loadBinary(
+      const BinaryDocumentReader& reader,
+      const QString& path,
+      const score::DocumentContext& ctx,
+      score::DocumentDelegateModel*& ptr,
+      score::DocumentModel* parent) override;
 };
 
 } // namespace SEGMent
@@ -8,6 +8,9 @@
 
 #include <SEGMent/Visitors.hpp>
 
+#include <QJsonArray>
+#include <QJsonObject>
+
 namespace SEGMent
 {
 /**
@@ -24,7 +27,30 @@ struct ExportVisitor
     if(!scene.ambience().path().isEmpty())
       copyFile(scene.ambience().path());
 
-    dispatchSceneChildren(scene, *this);
+    if (scene.hasPendingChildren())
+      pendingChildren(scene.pendingChildren());
+    else
+      dispatchSceneChildren(scene, *this);
+  }
+
+  //! The children of a scene loaded lazily are read from their save data,
+  //! without creating them.
+  void pendingChildren(const QJsonObject& children)
+  {
+    for (const char* key : sceneChildrenKeys)
+    {
+      for (const auto& child : children[key].toArray())
+      {
+        const auto obj = child.toObject();
+        const auto image = obj["Image"];
+        if (image.isString())
+          copyFile(image.toString());
+
+        const auto sound = obj["Sound"].toObject().value("Path").toString();
+        if (!sound.isEmpty())
+          copyFile(sound);
+      }
+    }
   }
 
   void operator()(const TransitionModel& obj)
@@ -20,6 +20,9 @@
 #include <unordered_map>
 
 #include <score/tools/std/StringHash.hpp>
+
+#include <SEGMent/RenderCachePolicy.hpp>
+#include <SEGMent/RenderProfiler.hpp>
 #undef small
 
 namespace SEGMent
@@ -189,6 +192,15 @@ public:
   {
     return *self;
   }
+
+  //! Lookups served from the cache, and lookups which had to rescale the image.
+  struct Statistics
+  {
+    qint64 hits{};
+    qint64 misses{};
+  };
+  const Statistics& statistics() const noexcept { return m_stats; }
+
   const QPixmap& inspector(const QFileInfo& path)
   {
     if(auto it = m_cache.find(path.absoluteFilePath());
@@ -196,6 +208,7 @@ public:
        path.lastModified().toSecsSinceEpoch() == it->second.lastChangeTimestamp &&
        QFileInfo(it->second.inspector).exists())
     {
+        m_stats.hits++;
         return it->second.inspectorPixmap();
     }
     else
@@ -211,6 +224,7 @@ public:
        path.lastModified().toSecsSinceEpoch() == it->second.lastChangeTimestamp &&
        QFileInfo(it->second.small).exists())
     {
+        m_stats.hits++;
         return it->second.smallPixmap();
     }
     else
@@ -226,6 +240,7 @@ public:
        path.lastModified().toSecsSinceEpoch() == it->second.lastChangeTimestamp &&
        QFileInfo(it->second.large).exists())
     {
+      m_stats.hits++;
       return it->second.largePixmap();
     }
     else
@@ -241,6 +256,7 @@ public:
        path.lastModified().toSecsSinceEpoch() == it->second.lastChangeTimestamp &&
        QFileInfo(it->second.full).exists())
     {
+        m_stats.hits++;
         return it->second.fullPixmap();
     }
     else
@@ -260,6 +276,7 @@ public:
        QFileInfo(it->second.inspector).exists()
      )
     {
+      m_stats.hits++;
       return it->second;
     }
     else
@@ -271,6 +288,7 @@ public:
 private:
   CacheInstance& createCache(const QFileInfo& info)
   {
+    m_stats.misses++;
     const auto& path = info.absoluteFilePath();
     auto& c = m_cache[path];
 
@@ -321,6 +339,7 @@ private:
   }
 
   impl m_cache;
+  Statistics m_stats;
   ImageCache(const ImageCache&) = default;
   ImageCache(ImageCache&&) = default;
   ImageCache& operator=(const ImageCache&) = default;
@@ -337,7 +356,17 @@ private:
 class LODPixmapItem : public QGraphicsItem
 {
 public:
-  using QGraphicsItem::QGraphicsItem;
+  explicit LODPixmapItem(QGraphicsItem* parent = nullptr)
+      : QGraphicsItem{parent}
+  {
+    // Needed to know when the resolution of the cache must change
+    setFlag(ItemSendsGeometryChanges);
+  }
+
+  ~LODPixmapItem() override
+  {
+    RenderCachePolicy::instance().release(*this);
+  }
 
   void setPixmap(const CacheInstance& cache)
   {
@@ -345,6 +374,7 @@ public:
     this->cache = &cache;
     if(cache.full_size.width() < 1)
         cache.fullPixmap();
+    RenderCachePolicy::instance().setKind(*this, RenderCachePolicy::Image);
     update();
   }
   QRectF boundingRect() const override
@@ -357,6 +387,7 @@ public:
 
   void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override
   {
+    RenderProfiler::Scope profile{RenderProfiler::LODPixmapItem};
     const auto lod = option->levelOfDetailFromTransform(painter->worldTransform());
 
     if(cache)
@@ -379,6 +410,14 @@ public:
     }
   }
 
+protected:
+  QVariant itemChange(GraphicsItemChange change, const QVariant& value) override
+  {
+    if (change == ItemScaleHasChanged || change == ItemSceneHasChanged)
+      RenderCachePolicy::instance().update(*this);
+    return QGraphicsItem::itemChange(change, value);
+  }
+
 private:
   const CacheInstance* cache{};
 };
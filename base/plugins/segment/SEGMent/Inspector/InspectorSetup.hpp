@@ -196,7 +196,7 @@ struct WidgetFactory
           const auto& cur = (object.*T::get)();
           if (auto txt = l->toPlainText(); txt != cur)
           {
-            CommandDispatcher<> disp{ctx.commandStack};
+            CommandDispatcher<SendStrategy::Merge> disp{ctx.commandStack};
             disp.submitCommand(new cmd{object, txt});
           }
         });
@@ -236,7 +236,8 @@ struct WidgetFactory
 
             if (str != cur)
             {
-              CommandDispatcher<> disp{ctx.commandStack};
+              CommandDispatcher<SendStrategy::Merge> disp{
+                  ctx.commandStack};
               disp.submitCommand(new cmd{object, str});
             }
           });
@@ -318,7 +319,7 @@ struct WidgetFactory
           [l, &object = this->object, &ctx = this->ctx](const auto& txt) {
             if (!l->hasFocus())
             {
-              CommandDispatcher<> disp{ctx.commandStack};
+              CommandDispatcher<SendStrategy::Merge> disp{ctx.commandStack};
               Sound s = (object.*T::get)();
               if (s.path() != txt)
               {
@@ -418,7 +419,20 @@ struct WidgetFactory
 
       QObject::connect(
           sl, &QSlider::sliderReleased, parent, [& ctx = this->ctx] {
-            ctx.dispatcher.commit();
+            ctx.dispatcher.template commit<SendStrategy::Merge>();
+          });
+
+      // Keyboard, wheel and clicks on the groove
+      QObject::connect(
+          sl,
+          &QSlider::valueChanged,
+          parent,
+          [sl, &object = this->object, &ctx = this->ctx](int volume) {
+            if (sl->isSliderDown())
+              return;
+            SoundPlayer::instance().setVolume(volume);
+            CommandDispatcher<SendStrategy::Merge> disp{ctx.commandStack};
+            disp.submitCommand(new SetVolume<U>{object, volume / 100.});
           });
       sl->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
       lay->addWidget(sl);
@@ -542,8 +556,7 @@ struct WidgetFactory
             cur.maxTime = time;
           }
 
-
-          CommandDispatcher<> disp{ctx.commandStack};
+          CommandDispatcher<SendStrategy::Merge> disp{ctx.commandStack};
           disp.submitCommand(new ChangeRiddle{object, cur});
         }
       });
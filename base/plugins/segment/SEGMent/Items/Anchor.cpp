@@ -9,6 +9,8 @@
 #include <QMimeData>
 
 #include <SEGMent/Model/Layer/ProcessView.hpp>
+#include <SEGMent/RenderCachePolicy.hpp>
+#include <SEGMent/RenderProfiler.hpp>
 #include <wobjectimpl.h>
 
 W_OBJECT_IMPL(SEGMent::Anchor)
@@ -24,6 +26,7 @@ Anchor::Anchor(qreal w, anchor_id i, QGraphicsItem* parent, ZoomView& view)
   setCursor(Qt::CrossCursor);
   setZValue(10);
   setAcceptDrops(true);
+  RenderCachePolicy::instance().setKind(*this, RenderCachePolicy::Fixed);
 }
 
 QRectF Anchor::boundingRect() const
@@ -94,6 +97,7 @@ void Anchor::paint(
     const QStyleOptionGraphicsItem* option,
     QWidget* widget)
 {
+  RenderProfiler::Scope profile{RenderProfiler::Anchor};
   const auto& skin = Style::instance();
   painter->setPen(skin.anchorPen);
   painter->setBrush(skin.anchorBrush);
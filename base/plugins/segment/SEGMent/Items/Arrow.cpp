@@ -7,6 +7,8 @@
 #include <QtMath>
 
 #include <SEGMent/Commands/Properties.hpp>
+#include <SEGMent/RenderCachePolicy.hpp>
+#include <SEGMent/RenderProfiler.hpp>
 namespace SEGMent
 {
 
@@ -24,6 +26,7 @@ Arrow::Arrow(
     , m_endItem{endItem}
 {
   setAcceptDrops(true);
+  RenderCachePolicy::instance().setKind(*this, RenderCachePolicy::Line);
   con(t.selection, &Selectable::changed, this, &Arrow::setSelected);
   connect(&startItem, &Anchor::moved, this, &Arrow::updateShape);
   connect(&endItem, &Anchor::moved, this, &Arrow::updateShape);
@@ -59,6 +62,7 @@ void Arrow::paint(
     const QStyleOptionGraphicsItem* option,
     QWidget* widget)
 {
+  RenderProfiler::Scope profile{RenderProfiler::Arrow};
   QLineF l = line();
   const auto& style = m_model.transition().target<SceneToScene>()
                           ? Style::instance().sceneArrow
@@ -10,6 +10,7 @@
 #include <SEGMent/Commands/Properties.hpp>
 #include <SEGMent/Items/ClickWindow.hpp>
 #include <SEGMent/Items/GlobalVariables.hpp>
+#include <SEGMent/RenderCachePolicy.hpp>
 namespace SEGMent
 {
 
@@ -136,6 +137,7 @@ BackClickWindow::BackClickWindow(
 
   m_sizeGripItem = new SizeGripItem(
       new ObjectResizer<BackClickWindow, false>{*this}, this, true);
+  RenderCachePolicy::instance().setKind(*this, RenderCachePolicy::Text);
 
   con(p.selection, &Selectable::changed, this, [=](bool b) {
     m_selection = b;
@@ -254,6 +256,7 @@ TextWindow::TextWindow(
 
   m_sizeGripItem = new SizeGripItem(
       new ObjectResizer<TextWindow, false>{*this}, this, true);
+  RenderCachePolicy::instance().setKind(*this, RenderCachePolicy::Text);
 
   con(p.selection, &Selectable::changed, this, [=](bool b) {
     m_selection = b;
@@ -8,9 +8,12 @@
 #include <QPen>
 
 #include <SEGMent/Commands/CommandFactory.hpp>
+#include <SEGMent/Items/ObjectWindow.hpp>
 #include <SEGMent/Items/RectItem.hpp>
 #include <SEGMent/Items/Window.hpp>
 #include <SEGMent/Model/Layer/ProcessView.hpp>
+#include <SEGMent/RenderCachePolicy.hpp>
+#include <SEGMent/RenderProfiler.hpp>
 #include <wobjectimpl.h>
 W_OBJECT_IMPL(SEGMent::RectItem)
 
@@ -32,11 +35,16 @@ RectItem::RectItem(
     , m_posConstrainedToParent{constrainPosToParent}
 {
   setFlag(ItemHasNoContents, true);
-  setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+  RenderCachePolicy::instance().setKind(*this, RenderCachePolicy::Fill);
 
   setAcceptDrops(false);
 }
 
+RectItem::~RectItem()
+{
+  RenderCachePolicy::instance().release(*this);
+}
+
 void RectItem::setMinSize(qreal minWidth, qreal minHeight)
 {
   m_minWidth = minWidth;
@@ -67,6 +75,7 @@ void RectItem::setRect(const QRectF& rect)
   }
 
   QGraphicsRectItem::setRect(rect);
+  RenderCachePolicy::instance().update(*this);
 
   for (unsigned long i = 0; i < m_childWindows.size(); ++i)
   {
@@ -111,6 +120,10 @@ void RectItem::mouseMoveEvent(QGraphicsSceneMouseEvent* event)
 
 void RectItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
+    // Only images and the parts of scenes use this paint function
+    RenderProfiler::Scope profile{
+        type() == ImageWindow::static_type() ? RenderProfiler::ImageWindow
+                                             : RenderProfiler::SceneWindow};
     const auto lod = option->levelOfDetailFromTransform(painter->worldTransform());
     if(lod * this->rect().width() < 5.)
         return;
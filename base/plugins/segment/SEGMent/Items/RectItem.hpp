@@ -32,6 +32,7 @@ public:
       const score::DocumentContext& ctx,
       ZoomView& view,
       QGraphicsItem* parent = Q_NULLPTR);
+  ~RectItem() override;
   void setMinSize(qreal minWidth, qreal minHeight);
   void setRect(const QRectF& rect);
   void setRect(qreal x, qreal y, qreal w, qreal h);
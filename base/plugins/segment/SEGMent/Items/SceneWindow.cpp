@@ -12,6 +12,7 @@
 #include <QMimeData>
 #include <QPainter>
 #include <QStyleOption>
+#include <QTimer>
 
 #include <SEGMent/Commands/Creation.hpp>
 #include <SEGMent/Commands/Deletion.hpp>
@@ -21,6 +22,7 @@
 #include <SEGMent/Items/GlobalVariables.hpp>
 #include <SEGMent/Items/ObjectWindow.hpp>
 #include <SEGMent/Items/SceneWindow.hpp>
+#include <SEGMent/Model/Layer/ProcessView.hpp>
 #include <SEGMent/Model/Scene.hpp>
 #include <SEGMent/ImageCache.hpp>
 #include <score/widgets/SignalUtils.hpp>
@@ -33,24 +35,31 @@ class SceneResizer final : public SizeGripItem::Resizer
 public:
   SceneResizer(SceneWindow& w) : self{w} {}
   SceneWindow& self;
-  void start(QGraphicsItem* item) override {}
+  std::vector<const SceneModel*> scenes;
+  qreal startWidth{};
+
+  void start(QGraphicsItem* item) override
+  {
+    // The whole selection is scaled like the scene being resized
+    scenes = self.selectedScenes();
+    startWidth = self.model().rect().width();
+  }
 
   void operator()(QGraphicsItem* item, QRectF& rect) override
   {
-    auto new_rect
-        = QRectF{self.pos().x(),
-                 self.pos().y(),
-                 rect.width(),
-                 self.rect().height() / self.rect().width() * rect.width()};
+    if (scenes.empty() || startWidth <= 0.)
+      return;
+
     auto rectItem = static_cast<SceneWindow*>(item);
-    self.context.dispatcher.submitCommand<SEGMent::SetSceneRect>(
-        self.model(), new_rect);
+    self.context.dispatcher.submitCommand<SEGMent::TransformScenes>(
+        self.process(), scenes, QPointF{}, rect.width() / startWidth);
     rect = rectItem->rect();
   }
 
   void finish(QGraphicsItem* item) override
   {
     self.context.dispatcher.commit();
+    scenes.clear();
   }
 };
 SceneWindow::SceneWindow(
@@ -156,7 +165,11 @@ SceneWindow::SceneWindow(
   }, Qt::QueuedConnection);
 
 
-  ossia::for_each_in_tuple(m_items, [this] (auto& item) { item.init(*this); });
+  // The objects of a scene loaded lazily get their windows once they exist
+  if (p.hasPendingChildren())
+    con(p, &SceneModel::childrenLoaded, this, [this] { initChildWindows(); });
+  else
+    initChildWindows();
 
   ::bind(p, SceneModel::p_image{}, this, [=, &ctx](const Image& img) {
     setBackgroundImage(ImageCache::instance().cache(toLocalFile(img.path, ctx)));
@@ -165,7 +178,9 @@ SceneWindow::SceneWindow(
     setTitle(img);
   });
   ::bind(p, SceneModel::p_rect{}, this, [=](auto rect) {
-    setRect({0, 0, rect.width(), rect.height()});
+    // Moving a scene must not relayout its contents
+    if (this->rect().size() != rect.size())
+      setRect({0, 0, rect.width(), rect.height()});
     setPos({rect.x(), rect.y()});
   });
 }
@@ -176,6 +191,31 @@ SceneWindow::~SceneWindow()
 }
 
 
+void SceneWindow::initChildWindows()
+{
+  ossia::for_each_in_tuple(m_items, [this] (auto& item) { item.init(*this); });
+}
+
+void SceneWindow::paint(
+    QPainter* painter,
+    const QStyleOptionGraphicsItem* option,
+    QWidget* widget)
+{
+  Window::paint(painter, option, widget);
+
+  // A scene loaded lazily creates its objects the first time it is drawn
+  // large enough for them to be seen; not while painting though.
+  if (m_childrenRequested || !m_scene.hasPendingChildren())
+    return;
+
+  const auto lod = option->levelOfDetailFromTransform(painter->worldTransform());
+  if (lod * rect().width() < 5. || lod * rect().height() < 5.)
+    return;
+
+  m_childrenRequested = true;
+  QTimer::singleShot(0, this, [this] { loadChildren(); });
+}
+
 void SceneWindow::setTitle(QString title)
 {
   m_title.setText(title);
@@ -283,6 +323,9 @@ void SceneWindow::dropEvent(QGraphicsSceneDragDropEvent* event)
   QPointF pos{localPos.x() / this->boundingRect().width(),
               localPos.y() / this->boundingRect().height()};
 
+  // The new objects get ids which are not used by the existing ones
+  loadChildren();
+
   if (currentMimeData->hasUrls())
   {
     if (currentMimeData->text() == SEGMENT_OBJECT_ID)
@@ -355,7 +398,6 @@ void SceneWindow::dropEvent(QGraphicsSceneDragDropEvent* event)
   return;
 }
 
-constexpr qreal max_dim = 20000.;
 QVariant
 SceneWindow::itemChange(GraphicsItemChange change, const QVariant& value)
 {
@@ -364,8 +406,8 @@ SceneWindow::itemChange(GraphicsItemChange change, const QVariant& value)
     case GraphicsItemChange::ItemPositionChange:
     {
       QPointF pt = value.toPointF();
-      pt.setX(qBound(-max_dim, pt.x(), max_dim));
-      pt.setY(qBound(-max_dim, pt.y(), max_dim));
+      pt.setX(qBound(-maxSceneCoordinate, pt.x(), maxSceneCoordinate));
+      pt.setY(qBound(-maxSceneCoordinate, pt.y(), maxSceneCoordinate));
       return pt;
     }
     case GraphicsItemChange::ItemSelectedChange:
@@ -442,10 +484,55 @@ QString imageToBase64(const QImage& image)
 }
 
 
+std::vector<const SceneModel*> SceneWindow::selectedScenes() const
+{
+  std::vector<const SceneModel*> scenes;
+
+  const auto& sel = context.selectionStack.currentSelection();
+  if(!sel.contains(&m_scene))
+  {
+    scenes.push_back(&m_scene);
+    return scenes;
+  }
+
+  scenes.reserve(sel.size());
+  for(auto& obj : sel)
+  {
+    if(auto scene = dynamic_cast<const SceneModel*>(obj.data()))
+    {
+      scenes.push_back(scene);
+    }
+  }
+  return scenes;
+}
+
+void SceneWindow::addChildWindow(const QObject& model, Window& window)
+{
+  m_view.addWindow(model, window);
+}
+
+void SceneWindow::removeChildWindow(const QObject& model)
+{
+  m_view.removeWindow(model);
+}
+
+const ProcessModel& SceneWindow::process() const
+{
+  return *safe_cast<ProcessModel*>(m_scene.parent());
+}
+
+void SceneWindow::loadChildren() const
+{
+  // Creating the children is not an edit of the document: the scene is
+  // reached through the process which owns it, like a command would.
+  process().scenes.at(m_scene.id()).loadChildren();
+}
+
 void SceneWindow::mousePressEvent(QGraphicsSceneMouseEvent* event)
 {
   if(event->button() == Qt::LeftButton)
   {
+    m_moving = false;
     QGraphicsRectItem::mousePressEvent(event);
   }
   event->accept();
@@ -455,7 +542,18 @@ void SceneWindow::mouseMoveEvent(QGraphicsSceneMouseEvent* event)
 {
   if(event->buttons() & Qt::LeftButton)
   {
-    QGraphicsRectItem::mouseMoveEvent(event);
+    // The selected scenes are moved by updating a single command,
+    // instead of letting QGraphicsItem move each item.
+    if(!m_moving)
+    {
+      m_movedScenes = selectedScenes();
+      m_moving = true;
+    }
+
+    const QPointF translation
+        = event->scenePos() - event->buttonDownScenePos(Qt::LeftButton);
+    context.dispatcher.submitCommand<TransformScenes>(
+        process(), m_movedScenes, translation, 1.);
   }
   event->accept();
 }
@@ -464,43 +562,16 @@ void SceneWindow::mouseReleaseEvent(QGraphicsSceneMouseEvent* event)
 {
   if(event->button() == Qt::LeftButton)
   {
-    QGraphicsRectItem::mouseReleaseEvent(event);
+    if(m_moving)
     {
-      std::vector<const SceneModel*> scenes;
-
-      for(auto& obj : context.selectionStack.currentSelection())
-      {
-        if(auto scene = dynamic_cast<const SceneModel*>(obj.data()))
-        {
-          scenes.push_back(scene);
-        }
-      }
-
-      if(!scenes.empty())
-      {
-        QPointF translation = event->scenePos() - event->buttonDownScenePos(Qt::LeftButton);
-        auto aggr = new MoveSceneRects;
-        for(auto scene : scenes)
-        {
-          auto rect = scene->rect();
-          if(scene != &m_scene)
-          {
-            double x = qBound(-max_dim, rect.x() + translation.x(), max_dim);
-            double y = qBound(-max_dim, rect.y() + translation.y(), max_dim);
-
-            aggr->addCommand(new SetSceneRect{*scene, QRectF{x, y, rect.width(), rect.height()}});
-          }
-          else
-          {
-            double x = qBound(-max_dim, this->pos().x(), max_dim);
-            double y = qBound(-max_dim, this->pos().y(), max_dim);
-
-            aggr->addCommand(new SetSceneRect{*scene, QRectF{x, y, rect.width(), rect.height()}});
-          }
-        }
-
-        context.commandStack.redoAndPush(aggr);
-      }
+      context.dispatcher.commit();
+      m_movedScenes.clear();
+      m_moving = false;
+    }
+    else
+    {
+      // Updates the selection when clicking without dragging
+      QGraphicsRectItem::mouseReleaseEvent(event);
     }
   }
 
@@ -12,6 +12,7 @@ class ClickWindow;
 class BackClickWindow;
 class TextWindow;
 class ClickAreaModel;
+class ProcessModel;
 
 //!
 class HLineItem : public QGraphicsItem, public QObject
@@ -74,7 +75,25 @@ public:
   int type() const final override { return static_type(); }
 
   auto& childWindows() const { return m_childWindows; }
+
+  //! Calls f(model, window) for each object of the scene.
+  template <typename F>
+  void forEachChildWindow(F&& f) const
+  {
+    ossia::for_each_in_tuple(m_items, [&](const auto& set) {
+      for (const auto& [model, window] : set.m_objects)
+        f(*model, *window);
+    });
+  }
   const SceneModel& model() const { return m_scene; }
+  const ProcessModel& process() const;
+
+  //! Creates the objects of the scene if it was loaded lazily.
+  void loadChildren() const;
+
+  //! The selected scenes if this one is part of the selection,
+  //! else only this one.
+  std::vector<const SceneModel*> selectedScenes() const;
 
   void setTitle(QString title);
   void setBackgroundImage(CacheInstance& img);
@@ -83,6 +102,10 @@ public:
 
   void dropEvent(QGraphicsSceneDragDropEvent* event) override;
 
+  void paint(
+      QPainter* painter,
+      const QStyleOptionGraphicsItem* option,
+      QWidget* widget) override;
 
 private:
   void mousePressEvent(QGraphicsSceneMouseEvent* event) override;
@@ -113,6 +136,15 @@ private:
 
   qreal m_backgroundImgRealWidth{100.0};
 
+  std::vector<const SceneModel*> m_movedScenes;
+  bool m_moving{};
+  bool m_childrenRequested{};
+
+  void initChildWindows();
+
+  void addChildWindow(const QObject& model, Window& window);
+  void removeChildWindow(const QObject& model);
+
   template<typename T>
   struct ChildWindowSet : public Nano::Observer
   {
@@ -135,6 +167,7 @@ private:
       }
 
       model_elements.added.template connect<&ChildWindowSet::on_created>(this);
+      model_elements.added_range.template connect<&ChildWindowSet::on_createdRange>(this);
       model_elements.removed.template connect<&ChildWindowSet::on_removed>(this);
     }
 
@@ -143,6 +176,15 @@ private:
       auto sc = new view_type{object, parent->context, parent->m_view, &parent->m_sceneArea};
       parent->m_childWindows.push_back(sc);
       m_objects.insert({&object, sc});
+      parent->addChildWindow(object, *sc);
+    }
+
+    void on_createdRange(const std::vector<T*>& objects)
+    {
+      for (auto o : objects)
+      {
+        on_created(*o);
+      }
     }
 
     void on_removed(const T& object)
@@ -160,6 +202,7 @@ private:
         }
 
         m_objects.erase(it);
+        parent->removeChildWindow(object);
         delete ptr;
       }
     }
@@ -22,28 +22,39 @@ Presenter::Presenter(
 {
   const SEGMent::ProcessModel& p = layer;
 
-  for (const auto& scene : p.scenes)
-  {
-    on_sceneCreated(scene);
-  }
+  on_scenesCreated(p.scenes.map().as_vec());
 
   p.scenes.added.connect<&Presenter::on_sceneCreated>(this);
+  p.scenes.added_range.connect<&Presenter::on_scenesCreated>(this);
   p.scenes.removed.connect<&Presenter::on_sceneRemoved>(this);
 
-  for (const auto& trans : p.transitions)
-  {
-    on_transitionCreated(trans);
-  }
+  on_transitionsCreated(p.transitions.map().as_vec());
 
   p.transitions.added.connect<&Presenter::on_transitionCreated>(this);
+  p.transitions.added_range.connect<&Presenter::on_transitionsCreated>(this);
   p.transitions.removed.connect<&Presenter::on_transitionRemoved>(this);
 }
 
-void Presenter::on_sceneCreated(const SceneModel& scene)
+SceneWindow* Presenter::makeScene(const SceneModel& scene)
 {
   auto sc = new SceneWindow(scene, context, m_view, nullptr);
   m_scenes.insert({&scene, sc});
-  m_view.addScene(sc);
+  return sc;
+}
+
+void Presenter::on_sceneCreated(const SceneModel& scene)
+{
+  m_view.addScene(makeScene(scene));
+}
+
+void Presenter::on_scenesCreated(const std::vector<SceneModel*>& scenes)
+{
+  std::vector<SceneWindow*> windows;
+  windows.reserve(scenes.size());
+  for (auto scene : scenes)
+    windows.push_back(makeScene(*scene));
+
+  m_view.addScenes(windows);
 }
 
 void Presenter::on_sceneRemoved(const SceneModel& scene)
@@ -56,7 +67,7 @@ void Presenter::on_sceneRemoved(const SceneModel& scene)
   }
 }
 
-void Presenter::on_transitionCreated(const TransitionModel& transition)
+Arrow* Presenter::makeTransition(const TransitionModel& transition)
 {
   // Find the start and end anchors of the transitions
 
@@ -98,13 +109,34 @@ void Presenter::on_transitionCreated(const TransitionModel& transition)
 
   auto [start, end]
       = ossia::apply(transition_matcher, transition.transition());
-  if (start && end)
-  {
-    auto t = new Arrow(transition, *start, *end, context, m_view, nullptr);
-    m_transitions.insert({&transition, t});
+  if (!start || !end)
+    return nullptr;
+
+  auto t = new Arrow(transition, *start, *end, context, m_view, nullptr);
+  m_transitions.insert({&transition, t});
+  return t;
+}
+
+void Presenter::on_transitionCreated(const TransitionModel& transition)
+{
+  if (auto t = makeTransition(transition))
     m_view.addTransition(t);
+}
+
+void Presenter::on_transitionsCreated(
+    const std::vector<TransitionModel*>& transitions)
+{
+  std::vector<Arrow*> arrows;
+  arrows.reserve(transitions.size());
+  for (auto transition : transitions)
+  {
+    if (auto t = makeTransition(*transition))
+      arrows.push_back(t);
   }
+
+  m_view.addTransitions(arrows);
 }
+
 void Presenter::on_transitionRemoved(const TransitionModel& transition)
 {
   auto it = m_transitions.find(&transition);
@@ -26,11 +26,16 @@ public:
       QObject* parent);
 
   void on_sceneCreated(const SceneModel&);
+  void on_scenesCreated(const std::vector<SceneModel*>&);
   void on_sceneRemoved(const SceneModel&);
   void on_transitionCreated(const TransitionModel&);
+  void on_transitionsCreated(const std::vector<TransitionModel*>&);
   void on_transitionRemoved(const TransitionModel&);
 
 private:
+  SceneWindow* makeScene(const SceneModel&);
+  Arrow* makeTransition(const TransitionModel&);
+
   const score::DocumentContext& context;
   ZoomView& m_view;
 
@@ -29,6 +29,8 @@
 #include <SEGMent/Document.hpp>
 #include <SEGMent/Items/Arrow.hpp>
 #include <SEGMent/Items/ObjectWindow.hpp>
+#include <SEGMent/RenderCachePolicy.hpp>
+#include <SEGMent/RenderProfiler.hpp>
 #include <wobjectimpl.h>
 #include <QGLWidget>
 #include <QGLFormat>
@@ -38,6 +40,9 @@ W_OBJECT_IMPL(SEGMent::ZoomView)
 
 namespace SEGMent
 {
+//! Delay after the last zoom step before the item caches are updated,
+//! in milliseconds.
+static constexpr int zoomSettleDelay = 200;
 
 ZoomView::ZoomView(const score::DocumentContext& ctx)
     : context{ctx}
@@ -46,6 +51,10 @@ ZoomView::ZoomView(const score::DocumentContext& ctx)
 {
   setDragMode(QGraphicsView::DragMode::RubberBandDrag);
 
+  m_cacheTimer.setSingleShot(true);
+  m_cacheTimer.setInterval(zoomSettleDelay);
+  connect(&m_cacheTimer, &QTimer::timeout, this, &ZoomView::on_zoomSettled);
+
   // setViewport(new QGLWidget(
   //     QGLFormat(QGL::SampleBuffers)));
   // setViewportUpdateMode(
@@ -100,15 +109,105 @@ void ZoomView::wheelEvent(QWheelEvent* event)
   }
 }
 
+void ZoomView::resizeEvent(QResizeEvent* event)
+{
+  QGraphicsView::resizeEvent(event);
+  visibleRectChanged();
+}
+
+void ZoomView::scrollContentsBy(int dx, int dy)
+{
+  QGraphicsView::scrollContentsBy(dx, dy);
+  visibleRectChanged();
+}
+
 void ZoomView::drawBackground(QPainter* painter, const QRectF& s)
 {
-  QBrush b = SEGMent::Style::instance().backgroundPen;
+  // The pattern does not depend on the zoom: it is drawn in device
+  // coordinates from a pre-rendered tile, aligned on the viewport origin.
+  const auto& tile
+      = RenderCachePolicy::instance().backgroundTile(devicePixelRatioF());
+  constexpr int tileSize = RenderCachePolicy::backgroundTileSize;
+
+  const QRect rect = painter->worldTransform().mapRect(s).toAlignedRect();
+  const auto offset = [=](int x) {
+    return qreal(((x % tileSize) + tileSize) % tileSize);
+  };
+
+  painter->save();
+  painter->resetTransform();
+  painter->drawTiledPixmap(
+      rect, tile, QPointF{offset(rect.x()), offset(rect.y())});
+  painter->restore();
+}
+
+void ZoomView::on_zoomSettled()
+{
+  const auto level = RenderCachePolicy::cacheZoomLevel(transform().m11());
+  if (level == m_cacheZoomLevel)
+    return;
+
+  m_cacheZoomLevel = level;
+  if (auto s = scene())
+    RenderCachePolicy::instance().updateScene(*s);
+}
+
+void ZoomView::setProfilerVisible(bool b)
+{
+  if (b == m_showProfiler)
+    return;
+
+  m_showProfiler = b;
+  if (b)
+  {
+    // The overlay is drawn in viewport coordinates: partial updates
+    // would leave stale copies of it while scrolling.
+    m_updateModeBeforeProfiling = viewportUpdateMode();
+    setViewportUpdateMode(QGraphicsView::FullViewportUpdate);
+  }
+  else
+  {
+    setViewportUpdateMode(m_updateModeBeforeProfiling);
+  }
+  viewport()->update();
+}
+
+void ZoomView::paintEvent(QPaintEvent* event)
+{
+  auto& profiler = RenderProfiler::instance();
+  if (!m_showProfiler || !profiler.enabled())
+  {
+    QGraphicsView::paintEvent(event);
+    return;
+  }
+
+  profiler.beginFrame();
+  QGraphicsView::paintEvent(event);
+  profiler.endFrame(
+      items(viewport()->rect()).size(), scene()->items().size());
+}
+
+void ZoomView::drawForeground(QPainter* painter, const QRectF& s)
+{
+  if (!m_showProfiler)
+    return;
+
+  const auto text = RenderProfiler::instance().summary();
+  if (text.isEmpty())
+    return;
 
-  b.setTransform(QTransform(painter->worldTransform().inverted()).scale(2, 2));
-  painter->setBackground(SEGMent::Style::instance().backgroundBrush);
-  painter->setBackgroundMode(Qt::OpaqueMode);
-  painter->setBrush(b);
-  painter->fillRect(s, b);
+  painter->save();
+  painter->resetTransform();
+  painter->setFont(QFont("Monospace", 9));
+
+  const auto rect = painter->fontMetrics()
+                        .boundingRect(QRect{0, 0, 800, 600}, 0, text)
+                        .translated(10, 10);
+  painter->fillRect(
+      rect.adjusted(-5, -5, 5, 5), QColor::fromRgb(0, 0, 0, 180));
+  painter->setPen(Qt::white);
+  painter->drawText(rect, 0, text);
+  painter->restore();
 }
 
 tsl::hopscotch_map<QGraphicsItem*, bool> visibility_map;
@@ -170,10 +269,37 @@ void ZoomView::finishArrowDrop()
   visibility_map.clear();
 }
 
+void ZoomView::addWindow(const QObject& model, Window& window)
+{
+  m_windows[&model] = &window;
+}
+
+void ZoomView::removeWindow(const QObject& model)
+{
+  m_windows.erase(&model);
+}
+
 void ZoomView::addScene(SceneWindow* s)
 {
   scene()->addItem(s);
+  RenderCachePolicy::instance().updateTree(*s);
   m_sceneWindows.push_back(s);
+  addWindow(s->model(), *s);
+  update();
+}
+
+void ZoomView::addScenes(const std::vector<SceneWindow*>& s)
+{
+  auto& policy = RenderCachePolicy::instance();
+  auto& sc = *scene();
+  m_sceneWindows.reserve(m_sceneWindows.size() + s.size());
+  for (auto window : s)
+  {
+    sc.addItem(window);
+    policy.updateTree(*window);
+    m_sceneWindows.push_back(window);
+    addWindow(window->model(), *window);
+  }
   update();
 }
 
@@ -185,6 +311,11 @@ void ZoomView::removeScene(const SceneWindow* s)
     m_sceneWindows.erase(it);
   }
 
+  // The child windows are deleted along with the scene
+  removeWindow(s->model());
+  s->forEachChildWindow(
+      [this](const QObject& model, Window&) { removeWindow(model); });
+
   delete s;
 }
 
@@ -195,6 +326,18 @@ void ZoomView::addTransition(Arrow* a)
   update();
 }
 
+void ZoomView::addTransitions(const std::vector<Arrow*>& a)
+{
+  auto& sc = *scene();
+  m_sceneArrows.reserve(m_sceneArrows.size() + a.size());
+  for (auto arrow : a)
+  {
+    sc.addItem(arrow);
+    m_sceneArrows.push_back(arrow);
+  }
+  update();
+}
+
 void ZoomView::removeTransition(const Arrow* a)
 {
   auto it = ossia::find(m_sceneArrows, a);
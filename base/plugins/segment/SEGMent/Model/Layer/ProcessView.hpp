@@ -1,5 +1,8 @@
 #pragma once
+#include <ossia/detail/ptr_set.hpp>
+
 #include <QGraphicsView>
+#include <QTimer>
 
 #include <SEGMent/Items/GlobalVariables.hpp>
 #include <SEGMent/Items/SceneWindow.hpp>
@@ -10,29 +13,6 @@ namespace SEGMent
 {
 class Arrow;
 
-//! This class iterates on all scenes to find a child object which matches with
-//! a model.
-//! TODO if this becomes a performance bottleneck one day, replace this by a
-//! hash_map<model*, view*>
-template <typename Model_T, typename View_T>
-struct window_visitor
-{
-  Model_T& request;
-  Window* operator()(SceneWindow* parent)
-  {
-    for (auto cld : parent->childWindows())
-    {
-      if (cld->type() == View_T::static_type())
-      {
-        auto obj = static_cast<View_T*>(cld);
-        if (&obj->model() == &request)
-          return obj;
-      }
-    }
-    return nullptr;
-  }
-};
-
 class RectItem;
 inline double currentZoomLevel = 1.;
 //! A QGraphicsView which allows zooming / dezooming through wheel events
@@ -78,37 +58,55 @@ public:
     else
       Style::instance().sceneBorderPen.setWidthF(1);
 
+    m_cacheTimer.start();
+    visibleRectChanged();
   }
 
+  //! Zoom level at which the item caches are currently rasterized.
+  qreal cacheZoomLevel() const noexcept { return m_cacheZoomLevel; }
+
   void setStartAnchorForNewArrow(Anchor& startAnchor);
   void setEndAnchorForNewArrow(Anchor& endAnchor);
   void finishArrowDrop();
 
-  Window* findItem(ImageModel* obj);
+  //! Window which shows a given model, or nullptr if there is none
+  //! or if it is not of the requested type.
   template <typename View, typename Model>
-  Window* findItem(Model* obj)
+  View* findItem(const Model* obj) const
   {
     if (!obj)
       return nullptr;
 
-    for (auto v : m_sceneWindows)
-    {
-      if (auto p = window_visitor<Model, View>{*obj}(v))
-        return p;
-    }
-    return nullptr;
+    auto it = m_windows.find(obj);
+    if (it == m_windows.end() || it->second->type() != View::static_type())
+      return nullptr;
+    return static_cast<View*>(it->second);
   }
 
+  //! Registers the window of a model for findItem.
+  void addWindow(const QObject& model, Window& window);
+  void removeWindow(const QObject& model);
+
   void addScene(SceneWindow* s);
+  //! Adds a batch of scenes with a single repaint.
+  void addScenes(const std::vector<SceneWindow*>& s);
 
   void removeScene(const SceneWindow* s);
   void addTransition(Arrow* a);
+  //! Adds a batch of transitions with a single repaint.
+  void addTransitions(const std::vector<Arrow*>& a);
   void removeTransition(const Arrow* a);
 
   void dragMove(QPointF pos);
 
+  //! Shows the render profiling overlay and records frame timings.
+  void setProfilerVisible(bool b);
+
   void doubleClicked() W_SIGNAL(doubleClicked);
 
+  //! Sent when the part of the canvas shown in the view changes.
+  void visibleRectChanged() W_SIGNAL(visibleRectChanged);
+
 private:
   void enterEvent(QEvent* event) override;
 
@@ -116,7 +114,12 @@ private:
   void mouseMoveEvent(QMouseEvent*) override;
   void mouseReleaseEvent(QMouseEvent* event) override;
   void wheelEvent(QWheelEvent* event) override;
+  void resizeEvent(QResizeEvent* event) override;
+  void scrollContentsBy(int dx, int dy) override;
   void drawBackground(QPainter* painter, const QRectF& s) override;
+  void drawForeground(QPainter* painter, const QRectF& s) override;
+  void paintEvent(QPaintEvent* event) override;
+  void on_zoomSettled();
 
   void dropEvent(QDropEvent* event) override;
   void dragEnterEvent(QDragEnterEvent* event) override;
@@ -127,9 +130,16 @@ private:
   const ProcessModel& m_process;
 
   std::vector<SceneWindow*> m_sceneWindows;
+  ossia::ptr_map<const QObject*, Window*> m_windows;
   std::vector<SEGMent::Arrow*> m_sceneArrows;
   Anchor* m_startAnchorForNewArrow{};
 
   QGraphicsLineItem* m_tmpArrow{};
+
+  QTimer m_cacheTimer;
+  qreal m_cacheZoomLevel{1.};
+
+  bool m_showProfiler{};
+  ViewportUpdateMode m_updateModeBeforeProfiling{};
 };
 } // namespace SEGMent
@@ -1,5 +1,9 @@
 #include "ProcessModel.hpp"
 
+#include <score/tools/Todo.hpp>
+
+#include <ossia/detail/algorithms.hpp>
+
 #include <QApplication>
 
 #include <SEGMent/Model/BackClickArea.hpp>
@@ -12,11 +16,48 @@
 #include <SEGMent/Model/Transition.hpp>
 namespace SEGMent
 {
+namespace
+{
+// Transition paths end with the scene or with the scene then the object.
+Id<SceneModel> sceneId(const ObjectIdentifier& id) noexcept
+{
+  return Id<SceneModel>{id.id()};
+}
+
+Id<SceneModel> sourceScene(const SceneToScene& t) noexcept
+{
+  return sceneId(t.from.unsafePath().vec().back());
+}
+
+template <typename T>
+Id<SceneModel> sourceScene(const T& t) noexcept
+{
+  const auto& vec = t.from.unsafePath().vec();
+  SCORE_ASSERT(vec.size() >= 2);
+  return sceneId(vec[vec.size() - 2]);
+}
+
+const std::vector<TransitionModel*> emptyTransitions;
+
+void removeTransition(
+    std::vector<TransitionModel*>& vec,
+    const TransitionModel* trans) noexcept
+{
+  auto it = ossia::find(vec, trans);
+  if (it != vec.end())
+  {
+    // Order does not matter
+    std::swap(*it, vec.back());
+    vec.pop_back();
+  }
+}
+}
 
 ProcessModel::ProcessModel(Id<SEGMent::ProcessModel> id, QObject* parent)
     : score::Entity<ProcessModel>{id, "SEGMentProcess", parent}
 {
   metadata().setInstanceName(*this);
+  init();
 
   //! When building in debug mode we set-up a default document...
 #if !defined(NDEBUG)
@@ -30,7 +71,7 @@ ProcessModel::ProcessModel(Id<SEGMent::ProcessModel> id, QObject* parent)
     obj1->setImage(Image{"Objects/enveloppe.png"});
     obj1->setPos({0.5, 0.7});
     obj1->setSize({0.3, 0.3});
-    scene1->objects.add(obj1);
+    scene1->objects().add(obj1);
 
     auto scene2 = new SceneModel{Id<SceneModel>{1}, this};
     scene2->setImage(Image{"Scenes/TableauDia1.png"});
@@ -41,12 +82,12 @@ ProcessModel::ProcessModel(Id<SEGMent::ProcessModel> id, QObject* parent)
     obj2->setImage(Image{"Objects/clef.png"});
     obj2->setPos({0.5, 0.7});
     obj2->setSize({0.3, 0.3});
-    scene2->objects.add(obj2);
+    scene2->objects().add(obj2);
 
     auto obj3 = new ClickAreaModel{Id<ClickAreaModel>{0}, scene2};
     obj3->setPos({0.2, 0.2});
     obj3->setSize({0.3, 0.3 * 640 / 480});
-    scene2->clickAreas.add(obj3);
+    scene2->clickAreas().add(obj3);
 
     ObjectToScene t{*obj1, *scene2, 6, 4};
     auto trans = new TransitionModel{t, Id<TransitionModel>{0}, this};
@@ -62,6 +103,100 @@ ProcessModel::~ProcessModel()
   identified_object_destroying(this);
 }
 
+void ProcessModel::init()
+{
+  transitions.added.connect<&ProcessModel::on_transitionAdded>(this);
+  transitions.added_range.connect<&ProcessModel::on_transitionsAdded>(this);
+  transitions.removing.connect<&ProcessModel::on_transitionRemoving>(this);
+}
+
+const std::vector<TransitionModel*>&
+ProcessModel::incomingTransitions(const SceneModel& scene) const noexcept
+{
+  auto it = m_sceneTransitions.find(scene.id());
+  return it != m_sceneTransitions.end() ? it->second.incoming
+                                        : emptyTransitions;
+}
+
+const std::vector<TransitionModel*>&
+ProcessModel::outgoingTransitions(const SceneModel& scene) const noexcept
+{
+  auto it = m_sceneTransitions.find(scene.id());
+  return it != m_sceneTransitions.end() ? it->second.outgoing
+                                        : emptyTransitions;
+}
+
+bool ProcessModel::startsFrom(
+    const TransitionModel& trans,
+    const QString& objectName,
+    int32_t id) noexcept
+{
+  return eggs::variants::apply(
+      [&](const auto& t) {
+        const auto& src = t.from.unsafePath().vec().back();
+        return src.id() == id && src.objectName() == objectName;
+      },
+      trans.transition());
+}
+
+void ProcessModel::on_transitionAdded(const TransitionModel& trans)
+{
+  auto& t = const_cast<TransitionModel&>(trans);
+  index(t);
+  con(trans, &TransitionModel::transitionChanged, this, [this, &t] {
+    unindex(t);
+    index(t);
+  });
+}
+
+void ProcessModel::on_transitionsAdded(
+    const std::vector<TransitionModel*>& trans)
+{
+  for (auto t : trans)
+    on_transitionAdded(*t);
+}
+
+void ProcessModel::on_transitionRemoving(const TransitionModel& trans)
+{
+  unindex(trans);
+}
+
+void ProcessModel::index(TransitionModel& trans)
+{
+  const auto& data = trans.transition();
+  auto source = eggs::variants::apply(
+      [](const auto& t) { return sourceScene(t); }, data);
+  auto target = eggs::variants::apply(
+      [](const auto& t) { return sceneId(t.to.unsafePath().vec().back()); },
+      data);
+
+  m_sceneTransitions[source].outgoing.push_back(&trans);
+  m_sceneTransitions[target].incoming.push_back(&trans);
+  m_indexed[&trans] = {source, target};
+}
+
+void ProcessModel::unindex(const TransitionModel& trans)
+{
+  auto it = m_indexed.find(&trans);
+  if (it == m_indexed.end())
+    return;
+
+  auto unindexScene = [&](const Id<SceneModel>& scene, auto member) {
+    auto sc = m_sceneTransitions.find(scene);
+    if (sc == m_sceneTransitions.end())
+      return;
+
+    auto& entry = sc.value();
+    removeTransition(entry.*member, &trans);
+    if (entry.incoming.empty() && entry.outgoing.empty())
+      m_sceneTransitions.erase(sc);
+  };
+
+  unindexScene(it->second.first, &SceneTransitions::outgoing);
+  unindexScene(it->second.second, &SceneTransitions::incoming);
+  m_indexed.erase(it);
+}
+
 } // namespace SEGMent
 
 template <>
@@ -87,11 +222,13 @@ void DataStreamWriter::write(SEGMent::ProcessModel& proc)
             typename std::remove_reference_t<decltype(map)>::value_type;
         int32_t sz;
         m_stream >> sz;
+        std::vector<entity_type*> objs;
+        objs.reserve(sz);
         for (; sz-- > 0;)
         {
-          auto obj = new entity_type{*this, &proc};
-          map.add(obj);
+          objs.push_back(new entity_type{*this, &proc});
         }
+        map.add_range(objs);
       });
   checkDelimiter();
 }
@@ -108,20 +245,24 @@ void JSONObjectWriter::write(SEGMent::ProcessModel& proc)
 {
   {
     const auto& objs = obj["Scenes"].toArray();
+    std::vector<SEGMent::SceneModel*> res;
+    res.reserve(objs.size());
     for (const auto& json_vref : objs)
     {
-      auto obj = new SEGMent::SceneModel{
-          JSONObject::Deserializer{json_vref.toObject()}, &proc};
-      proc.scenes.add(obj);
+      res.push_back(
+          SEGMent::SceneModel::loadLazily(json_vref.toObject(), &proc));
     }
+    proc.scenes.add_range(res);
   }
   {
     const auto& objs = obj["Transitions"].toArray();
+    std::vector<SEGMent::TransitionModel*> res;
+    res.reserve(objs.size());
     for (const auto& json_vref : objs)
     {
-      auto obj = new SEGMent::TransitionModel{
-          JSONObject::Deserializer{json_vref.toObject()}, &proc};
-      proc.transitions.add(obj);
+      res.push_back(new SEGMent::TransitionModel{
+          JSONObject::Deserializer{json_vref.toObject()}, &proc});
     }
+    proc.transitions.add_range(res);
   }
 }
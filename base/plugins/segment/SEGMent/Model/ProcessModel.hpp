@@ -1,17 +1,26 @@
 #pragma once
 #include <score/model/EntityMap.hpp>
 #include <score/tools/Metadata.hpp>
+#include <score/tools/std/HashMap.hpp>
+
+#include <ossia/detail/ptr_set.hpp>
 
 #include <SEGMent/Model/Scene.hpp>
 #include <SEGMent/Model/Transition.hpp>
+#include <nano_observer.hpp>
 namespace SEGMent
 {
 /**
  * @brief The actual root of a SEGMent document.
  *
  * Contains a set of scenes and a set of transitions.
+ *
+ * The transitions are also indexed by the scenes they start from and go to,
+ * so that the transitions of a scene or of one of its objects can be found
+ * without going through all the transitions of the document.
  */
-class ProcessModel final : public score::Entity<ProcessModel>
+class ProcessModel final : public score::Entity<ProcessModel>,
+                           public Nano::Observer
 {
   SCORE_SERIALIZE_FRIENDS
 
@@ -22,6 +31,7 @@ public:
   ProcessModel(Impl&& vis, QObject* parent)
       : score::Entity<ProcessModel>{vis, parent}
   {
+    init();
     vis.writeTo(*this);
   }
 
@@ -29,6 +39,58 @@ public:
 
   score::EntityMap<SceneModel> scenes;
   score::EntityMap<TransitionModel> transitions;
+
+  //! Transitions which go to a scene.
+  const std::vector<TransitionModel*>&
+  incomingTransitions(const SceneModel& scene) const noexcept;
+
+  //! Transitions which start from a scene or from one of its objects.
+  const std::vector<TransitionModel*>&
+  outgoingTransitions(const SceneModel& scene) const noexcept;
+
+  //! Transitions which start from an object of a scene.
+  template <typename T>
+  std::vector<TransitionModel*> outgoingTransitions(const T& object) const
+  {
+    std::vector<TransitionModel*> res;
+    // The segments of a path are named after the objects, e.g. "GifObject"
+    const auto name = object.objectName();
+    const auto& scene = *static_cast<const SceneModel*>(object.parent());
+    for (auto trans : outgoingTransitions(scene))
+    {
+      if (startsFrom(*trans, name, object.id().val()))
+        res.push_back(trans);
+    }
+    return res;
+  }
+
+private:
+  struct SceneTransitions
+  {
+    std::vector<TransitionModel*> incoming;
+    std::vector<TransitionModel*> outgoing;
+  };
+
+  void init();
+  void on_transitionAdded(const TransitionModel& trans);
+  void on_transitionsAdded(const std::vector<TransitionModel*>& trans);
+  void on_transitionRemoving(const TransitionModel& trans);
+  void index(TransitionModel& trans);
+  void unindex(const TransitionModel& trans);
+
+  static bool startsFrom(
+      const TransitionModel& trans,
+      const QString& objectName,
+      int32_t id) noexcept;
+
+  score::hash_map<Id<SceneModel>, SceneTransitions> m_sceneTransitions;
+
+  //! Source and target scenes under which each transition is indexed,
+  //! so that it can be unindexed after its transition data changed.
+  ossia::ptr_map<
+      const TransitionModel*,
+      std::pair<Id<SceneModel>, Id<SceneModel>>>
+      m_indexed;
 };
 } // namespace SEGMent
 
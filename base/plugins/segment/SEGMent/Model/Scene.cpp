@@ -1,8 +1,12 @@
 #include "Scene.hpp"
 #include <SEGMent/StringUtils.hpp>
+#include <score/tools/Todo.hpp>
 
+#include <QJsonDocument>
 #include <QUrl>
 
+#include <utility>
+
 #include <SEGMent/Model/Model.hpp>
 #include <SEGMent/ImageCache.hpp>
 #include <SEGMent/Visitors.hpp>
@@ -15,6 +19,180 @@ namespace SEGMent
 SceneModel::SceneModel(Id<SceneModel> id, QObject* parent)
     : base_type{std::move(id), "Scene", parent}
 {
+  init();
+}
+
+void SceneModel::init()
+{
+  // The objects of a scene are edited once it is selected
+  con(selection, &Selectable::changed, this, [this](bool b) {
+    if (b)
+      loadChildren();
+  });
+}
+
+QJsonObject SceneModel::takeChildren(QJsonObject& obj)
+{
+  QJsonObject children;
+  for (const char* key : sceneChildrenKeys)
+  {
+    auto it = obj.find(key);
+    if (it == obj.end())
+      continue;
+
+    if (!it.value().toArray().isEmpty())
+      children.insert(key, it.value());
+    obj.erase(it);
+  }
+  return children;
+}
+
+SceneModel* SceneModel::loadLazily(QJsonObject obj, QObject* parent)
+{
+  auto children = takeChildren(obj);
+  return loadLazily(obj, std::move(children), parent);
+}
+
+SceneModel* SceneModel::loadLazily(
+    const QJsonObject& obj,
+    QJsonObject children,
+    QObject* parent)
+{
+  auto scene = new SceneModel{JSONObject::Deserializer{obj}, parent};
+  scene->m_pendingChildren = std::move(children);
+  return scene;
+}
+
+void SceneModel::loadChildren()
+{
+  if (m_pendingChildren.isEmpty())
+    return;
+
+  // Emptied first, so that looking up a child while creating the others
+  // does not load them a second time.
+  const auto children = std::exchange(m_pendingChildren, QJsonObject{});
+
+  createChildren(children);
+  childrenLoaded();
+}
+
+bool SceneModel::loadLazyChildren()
+{
+  if (!hasPendingChildren())
+    return false;
+
+  loadChildren();
+  return true;
+}
+
+void SceneModel::createChildren(const QJsonObject& json)
+{
+  {
+    const auto& objs = json["Objects"].toArray();
+    for (const auto& json_vref : objs)
+    {
+      auto obj = new SEGMent::ImageModel{
+          JSONObject::Deserializer{json_vref.toObject()}, this};
+      m_objects.add(obj);
+    }
+  }
+  {
+    const auto& objs = json["Gifs"].toArray();
+    for (const auto& json_vref : objs)
+    {
+      auto obj = new SEGMent::GifModel{
+          JSONObject::Deserializer{json_vref.toObject()}, this};
+      m_gifs.add(obj);
+    }
+  }
+  {
+    const auto& objs = json["ClickAreas"].toArray();
+    for (const auto& json_vref : objs)
+    {
+      auto obj = new SEGMent::ClickAreaModel{
+          JSONObject::Deserializer{json_vref.toObject()}, this};
+      m_clickAreas.add(obj);
+    }
+  }
+  {
+    const auto& objs = json["BackClickAreas"].toArray();
+    for (const auto& json_vref : objs)
+    {
+      auto obj = new SEGMent::BackClickAreaModel{
+          JSONObject::Deserializer{json_vref.toObject()}, this};
+      m_backClickAreas.add(obj);
+    }
+  }
+  {
+    const auto& objs = json["TextAreas"].toArray();
+    for (const auto& json_vref : objs)
+    {
+      auto obj = new SEGMent::TextAreaModel{
+          JSONObject::Deserializer{json_vref.toObject()}, this};
+      m_textAreas.add(obj);
+    }
+  }
+}
+
+score::EntityMap<ImageModel>& SceneModel::objects()
+{
+  loadChildren();
+  return m_objects;
+}
+
+const score::EntityMap<ImageModel>& SceneModel::objects() const
+{
+  SCORE_ASSERT(!hasPendingChildren());
+  return m_objects;
+}
+
+score::EntityMap<GifModel>& SceneModel::gifs()
+{
+  loadChildren();
+  return m_gifs;
+}
+
+const score::EntityMap<GifModel>& SceneModel::gifs() const
+{
+  SCORE_ASSERT(!hasPendingChildren());
+  return m_gifs;
+}
+
+score::EntityMap<ClickAreaModel>& SceneModel::clickAreas()
+{
+  loadChildren();
+  return m_clickAreas;
+}
+
+const score::EntityMap<ClickAreaModel>& SceneModel::clickAreas() const
+{
+  SCORE_ASSERT(!hasPendingChildren());
+  return m_clickAreas;
+}
+
+score::EntityMap<BackClickAreaModel>& SceneModel::backClickAreas()
+{
+  loadChildren();
+  return m_backClickAreas;
+}
+
+const score::EntityMap<BackClickAreaModel>&
+SceneModel::backClickAreas() const
+{
+  SCORE_ASSERT(!hasPendingChildren());
+  return m_backClickAreas;
+}
+
+score::EntityMap<TextAreaModel>& SceneModel::textAreas()
+{
+  loadChildren();
+  return m_textAreas;
+}
+
+const score::EntityMap<TextAreaModel>& SceneModel::textAreas() const
+{
+  SCORE_ASSERT(!hasPendingChildren());
+  return m_textAreas;
 }
 
 const SceneModel::SceneType& SceneModel::sceneType() const MSVC_NOEXCEPT
@@ -68,6 +246,14 @@ const Image& SceneModel::image() const MSVC_NOEXCEPT
   return m_image;
 }
 
+QSize SceneModel::imageSize() const
+{
+  auto parent_doc = score::IDocument::documentFromObject(*this);
+  auto& cache = ImageCache::instance().cache(
+      toLocalFile(m_image.path, parent_doc->context()));
+  return cache.full_size;
+}
+
 void SceneModel::setImage(const Image& v) MSVC_NOEXCEPT
 {
   if (m_image != v)
@@ -232,15 +418,25 @@ void JSONObjectWriter::write(SEGMent::Cue& v)
 template <>
 void DataStreamReader::read(const SEGMent::SceneModel& v)
 {
-  // Serialize objects, gifs, etc
-  SEGMent::forEachCategoryInScene(v,
-      [&] (auto& map) {
-      m_stream << (int32_t)map.size();
-      for (const auto& obj : map)
-      {
-        readFrom(obj);
-      }
-  });
+  // Serialize objects, gifs, etc; those of a scene loaded lazily are kept
+  // as they were loaded, after a tag which cannot be a number of objects.
+  if (v.hasPendingChildren())
+  {
+    m_stream << SEGMent::SceneModel::pendingChildrenTag
+             << QJsonDocument{v.m_pendingChildren}.toJson(
+                    QJsonDocument::Compact);
+  }
+  else
+  {
+    SEGMent::forEachCategoryInScene(v,
+        [&] (auto& map) {
+        m_stream << (int32_t)map.size();
+        for (const auto& obj : map)
+        {
+          readFrom(obj);
+        }
+    });
+  }
 
   // Serialize scene properties
   m_stream << v.m_ambience << v.m_image << v.m_rect << v.m_sceneType
@@ -253,19 +449,36 @@ void DataStreamReader::read(const SEGMent::SceneModel& v)
 template <>
 void DataStreamWriter::write(SEGMent::SceneModel& v)
 {
-  // Deserialize objects, gifs, etc
-  SEGMent::forEachCategoryInScene(v,
-      [&] (auto& map) {
-        using entity_type = typename std::remove_reference_t<decltype(map)>::value_type;
-
-        int32_t sz;
-        m_stream >> sz;
-        for (; sz-- > 0;)
-        {
-          auto obj = new entity_type{*this, &v};
-          map.add(obj);
-        }
-  });
+  // Deserialize objects, gifs, etc. The first number is the count of
+  // objects, as in the data saved before the scenes were loaded lazily,
+  // unless it is the tag of the pending children.
+  int32_t first{};
+  m_stream >> first;
+  if (first == SEGMent::SceneModel::pendingChildrenTag)
+  {
+    QByteArray children;
+    m_stream >> children;
+    v.m_pendingChildren = QJsonDocument::fromJson(children).object();
+  }
+  else
+  {
+    bool read_first = false;
+    SEGMent::forEachCategoryInScene(v,
+        [&] (auto& map) {
+          using entity_type = typename std::remove_reference_t<decltype(map)>::value_type;
+
+          int32_t sz;
+          if (!std::exchange(read_first, true))
+            sz = first;
+          else
+            m_stream >> sz;
+          for (; sz-- > 0;)
+          {
+            auto obj = new entity_type{*this, &v};
+            map.add(obj);
+          }
+    });
+  }
 
   // Deserialize scene properties
   m_stream >> v.m_ambience >> v.m_image >> v.m_rect >> v.m_sceneType
@@ -280,20 +493,28 @@ void JSONObjectReader::read(const SEGMent::SceneModel& v)
 {
   using namespace SEGMent;
 
-  // Serialize objects, gifs, etc
-  obj["Objects"] = toJsonArray(v.objects);
-  obj["Gifs"] = toJsonArray(v.gifs);
-  obj["ClickAreas"] = toJsonArray(v.clickAreas);
-  obj["BackClickAreas"] = toJsonArray(v.backClickAreas);
-  obj["TextAreas"] = toJsonArray(v.textAreas);
+  // Serialize objects, gifs, etc; those of a scene loaded lazily are saved
+  // without being created.
+  if (v.hasPendingChildren())
+  {
+    for (const char* key : sceneChildrenKeys)
+      obj[key] = v.m_pendingChildren[key].toArray();
+  }
+  else
+  {
+    obj["Objects"] = toJsonArray(v.m_objects);
+    obj["Gifs"] = toJsonArray(v.m_gifs);
+    obj["ClickAreas"] = toJsonArray(v.m_clickAreas);
+    obj["BackClickAreas"] = toJsonArray(v.m_backClickAreas);
+    obj["TextAreas"] = toJsonArray(v.m_textAreas);
+  }
 
   // Serialize scene properties
   obj["Ambience"] = toJsonObject(v.m_ambience);
   obj["Image"] = v.m_image.path;
 
-  auto parent_doc = score::IDocument::documentFromObject(v);
-  auto& cache = SEGMent::ImageCache::instance().cache(SEGMent::toLocalFile(v.m_image.path, parent_doc->context()));
-  obj["ImageSize"] = QJsonArray{cache.full_size.width(), cache.full_size.height()};
+  const auto size = v.imageSize();
+  obj["ImageSize"] = QJsonArray{size.width(), size.height()};
   obj["Rect"] = toJsonValue(v.m_rect);
   obj["SceneType"] = (int)v.m_sceneType;
   obj["StartText"] = v.m_startText;
@@ -310,52 +531,8 @@ void JSONObjectWriter::write(SEGMent::SceneModel& v)
 {
   using namespace SEGMent;
 
-  // Serialize objects, gifs, etc
-  {
-    const auto& objs = obj["Objects"].toArray();
-    for (const auto& json_vref : objs)
-    {
-      auto obj = new SEGMent::ImageModel{
-          JSONObject::Deserializer{json_vref.toObject()}, &v};
-      v.objects.add(obj);
-    }
-  }
-  {
-    const auto& objs = obj["Gifs"].toArray();
-    for (const auto& json_vref : objs)
-    {
-      auto obj = new SEGMent::GifModel{
-          JSONObject::Deserializer{json_vref.toObject()}, &v};
-      v.gifs.add(obj);
-    }
-  }
-  {
-    const auto& objs = obj["ClickAreas"].toArray();
-    for (const auto& json_vref : objs)
-    {
-      auto obj = new SEGMent::ClickAreaModel{
-          JSONObject::Deserializer{json_vref.toObject()}, &v};
-      v.clickAreas.add(obj);
-    }
-  }
-  {
-    const auto& objs = obj["BackClickAreas"].toArray();
-    for (const auto& json_vref : objs)
-    {
-      auto obj = new SEGMent::BackClickAreaModel{
-          JSONObject::Deserializer{json_vref.toObject()}, &v};
-      v.backClickAreas.add(obj);
-    }
-  }
-  {
-    const auto& objs = obj["TextAreas"].toArray();
-    for (const auto& json_vref : objs)
-    {
-      auto obj = new SEGMent::TextAreaModel{
-          JSONObject::Deserializer{json_vref.toObject()}, &v};
-      v.textAreas.add(obj);
-    }
-  }
+  // Deserialize objects, gifs, etc
+  v.createChildren(obj);
 
   // Deserialize scene properties
   v.m_ambience = fromJsonObject<SEGMent::Sound>(obj["Ambience"]);
@@ -13,9 +13,18 @@
 #include <SEGMent/Model/Cue.hpp>
 #include <SEGMent/Model/SceneDataModels.hpp>
 
+#include <QJsonObject>
+#include <QSize>
+
 
 namespace SEGMent
 {
+//! Scenes are kept within [-maxSceneCoordinate; maxSceneCoordinate] on the canvas.
+constexpr qreal maxSceneCoordinate = 20000.;
+
+//! Keys of the children in the save data of a scene.
+constexpr const char* sceneChildrenKeys[]
+    = {"Objects", "Gifs", "ClickAreas", "BackClickAreas", "TextAreas"};
 
 //! A scene is the main object in a SEGMent canvas
 class SceneModel : public PathAsId<score::Entity<SceneModel>>
@@ -34,13 +43,74 @@ public:
       : base_type{std::forward<DeserializerVisitor>(vis), parent}
   {
     vis.writeTo(*this);
+    init();
+  }
+
+  /**
+   * @brief Loads a scene in two phases.
+   *
+   * Only the scene itself is created from its save data: its objects,
+   * gifs and areas are created the first time they are needed, i.e. when
+   * one of the accessors below is called, when the scene is selected or
+   * shown, or when a path to one of them is resolved.
+   */
+  static SceneModel* loadLazily(QJsonObject obj, QObject* parent);
+
+  //! Same, when the children were already taken out of the save data.
+  static SceneModel*
+  loadLazily(const QJsonObject& obj, QJsonObject children, QObject* parent);
+
+  //! Removes the children from the save data of a scene and returns them.
+  //! Does not touch any QObject: it can be called from any thread.
+  static QJsonObject takeChildren(QJsonObject& obj);
+
+  //! The children of the scene. The non-const accessors create them first
+  //! if they were not; the const ones cannot, hence they must not be called
+  //! before loadChildren on a scene loaded lazily.
+  score::EntityMap<ImageModel>& objects();
+  const score::EntityMap<ImageModel>& objects() const;
+  score::EntityMap<GifModel>& gifs();
+  const score::EntityMap<GifModel>& gifs() const;
+  score::EntityMap<ClickAreaModel>& clickAreas();
+  const score::EntityMap<ClickAreaModel>& clickAreas() const;
+  score::EntityMap<BackClickAreaModel>& backClickAreas();
+  const score::EntityMap<BackClickAreaModel>& backClickAreas() const;
+  score::EntityMap<TextAreaModel>& textAreas();
+  const score::EntityMap<TextAreaModel>& textAreas() const;
+
+  //! True while the children of a scene loaded lazily are not created.
+  bool hasPendingChildren() const noexcept
+  {
+    return !m_pendingChildren.isEmpty();
   }
 
-  score::EntityMap<ImageModel> objects;
-  score::EntityMap<GifModel> gifs;
-  score::EntityMap<ClickAreaModel> clickAreas;
-  score::EntityMap<BackClickAreaModel> backClickAreas;
-  score::EntityMap<TextAreaModel> textAreas;
+  //! Written in the DataStream format instead of the number of objects
+  //! when the children that follow are the pending ones, as JSON.
+  static constexpr int32_t pendingChildrenTag = -1;
+
+  //! Save data of the children which are not created yet.
+  const QJsonObject& pendingChildren() const noexcept
+  {
+    return m_pendingChildren;
+  }
+
+  //! Creates the pending children, then sends childrenLoaded.
+  void loadChildren();
+  void childrenLoaded() W_SIGNAL(childrenLoaded);
+
+  bool loadLazyChildren() override;
+
+private:
+  void init();
+  void createChildren(const QJsonObject& obj);
+
+  score::EntityMap<ImageModel> m_objects;
+  score::EntityMap<GifModel> m_gifs;
+  score::EntityMap<ClickAreaModel> m_clickAreas;
+  score::EntityMap<BackClickAreaModel> m_backClickAreas;
+  score::EntityMap<TextAreaModel> m_textAreas;
+
+  QJsonObject m_pendingChildren;
 
   //! Scene type
 public:
@@ -93,6 +163,10 @@ public:
   void imageChanged(const Image& v) W_SIGNAL(imageChanged, v);
   PROPERTY(Image, image READ image WRITE setImage NOTIFY imageChanged)
 
+  //! Size of the image file, as saved in "ImageSize". It is read from the
+  //! image cache, hence it can change with the file without a signal.
+  QSize imageSize() const;
+
 private:
   Image m_image;
 
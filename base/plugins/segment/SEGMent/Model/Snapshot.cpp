@@ -0,0 +1,367 @@
+#include <score/application/ApplicationContext.hpp>
+#include <score/document/DocumentContext.hpp>
+#include <score/plugins/documentdelegate/DocumentDelegateModel.hpp>
+#include <score/plugins/documentdelegate/plugin/SerializableDocumentPlugin.hpp>
+#include <score/serialization/JSONStreamWriter.hpp>
+#include <score/serialization/JSONVisitor.hpp>
+
+#include <core/application/ApplicationSettings.hpp>
+#include <core/document/Document.hpp>
+#include <core/document/DocumentModel.hpp>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMetaMethod>
+#include <QMetaProperty>
+#include <QSaveFile>
+#include <QThreadPool>
+
+#include <SEGMent/Exporter.hpp>
+#include <SEGMent/Model/ProcessModel.hpp>
+#include <SEGMent/Model/Snapshot.hpp>
+#include <SEGMent/Visitors.hpp>
+
+#include <wobjectimpl.h>
+
+namespace SEGMent
+{
+/**
+ * @brief Keeps the last snapshot of a scene or transition, and drops it
+ * as soon as the entity changes.
+ */
+class SnapshotTracker final : public QObject, public Nano::Observer
+{
+  W_OBJECT(SnapshotTracker)
+public:
+  std::shared_ptr<const EntitySnapshot> snapshot;
+
+  void touch() { snapshot.reset(); }
+  W_SLOT(touch)
+
+  //! Calls touch when a property of the object or of its metadata changes.
+  template <typename T>
+  void watchEntity(const T& obj)
+  {
+    watch(obj);
+    watch(obj.metadata());
+    connect(
+        &obj.metadata(),
+        &score::ModelMetadata::metadataChanged,
+        this,
+        &SnapshotTracker::touch);
+  }
+
+  //! Also tracks the objects of a scene, and their addition and removal.
+  void watchScene(const SceneModel& scene)
+  {
+    watchEntity(scene);
+
+    // The objects of a scene loaded lazily are tracked once they are
+    // created: until then they are saved as they were loaded.
+    if (scene.hasPendingChildren())
+    {
+      connect(&scene, &SceneModel::childrenLoaded, this, [this, &scene] {
+        watchChildren(scene);
+      });
+    }
+    else
+    {
+      watchChildren(scene);
+    }
+  }
+
+private:
+  void watchChildren(const SceneModel& scene)
+  {
+    forEachCategoryInScene(scene, [this](const auto& map) {
+      using entity_type =
+          typename std::remove_reference_t<decltype(map)>::value_type;
+      for (const auto& obj : map)
+        watchEntity(obj);
+
+      map.added.template connect<&SnapshotTracker::on_childAdded<entity_type>>(
+          this);
+      map.added_range
+          .template connect<&SnapshotTracker::on_childrenAdded<entity_type>>(
+              this);
+      map.removing
+          .template connect<&SnapshotTracker::on_childRemoving<entity_type>>(
+              this);
+    });
+  }
+
+  void watch(const QObject& obj)
+  {
+    static const QMetaMethod slot = staticMetaObject.method(
+        staticMetaObject.indexOfSlot("touch()"));
+
+    const auto mo = obj.metaObject();
+    for (int i = 0; i < mo->propertyCount(); i++)
+    {
+      const auto prop = mo->property(i);
+      if (prop.hasNotifySignal())
+        connect(&obj, prop.notifySignal(), this, slot);
+    }
+  }
+
+  template <typename T>
+  void on_childAdded(const T& obj)
+  {
+    watchEntity(obj);
+    touch();
+  }
+
+  template <typename T>
+  void on_childrenAdded(const std::vector<T*>& objs)
+  {
+    for (auto obj : objs)
+      watchEntity(*obj);
+    touch();
+  }
+
+  template <typename T>
+  void on_childRemoving(const T&)
+  {
+    touch();
+  }
+};
+
+namespace
+{
+template <typename T>
+std::shared_ptr<const EntitySnapshot> makeSnapshot(const T& entity)
+{
+  auto snap = std::make_shared<EntitySnapshot>();
+  snap->id = entity.id().val();
+  snap->json = score::marshall<JSONObject>(entity);
+
+  ExportVisitor vis{
+      [&](const QString& path) { snap->resources.push_back(path); }};
+  vis(entity);
+
+  return snap;
+}
+
+//! The size of the image of a scene is not a property: it is checked
+//! against the image cache each time, as the file may have changed.
+bool imageSizeChanged(const EntitySnapshot& snap, const SceneModel& scene)
+{
+  const auto size = scene.imageSize();
+  const auto saved = snap.json["ImageSize"].toArray();
+  return saved.size() != 2 || saved[0].toInt() != size.width()
+         || saved[1].toInt() != size.height();
+}
+} // namespace
+
+QByteArray EntitySnapshot::text(const JSONStreamWriter& writer) const
+{
+  // Autosaves write snapshots from worker threads
+  std::lock_guard<std::mutex> lock{m_textMutex};
+  auto& cached = m_text[writer.compact() ? 1 : 0];
+  if (cached.text.isNull() || cached.depth != writer.depth())
+    cached = Text{writer.depth(), writer.formatValue(json)};
+  return cached.text;
+}
+
+bool DocumentSnapshot::write(
+    QIODevice& device,
+    QJsonDocument::JsonFormat format) const
+{
+  JSONStreamWriter writer{device, format};
+
+  writer.beginObject();
+  writer.members(
+      document, {{"Document", [&] { writeDocument(writer); }}});
+  writer.endObject();
+
+  return writer.ok();
+}
+
+void DocumentSnapshot::writeDocument(JSONStreamWriter& writer) const
+{
+  auto entities = [&](const auto& snapshots) {
+    writer.beginArray();
+    for (const auto& entity : snapshots)
+      writer.rawValue(entity->text(writer));
+    writer.endArray();
+  };
+
+  const auto doc = document["Document"].toObject();
+  const auto process = doc["Process"].toObject();
+
+  writer.beginObject();
+  writer.members(doc, {{"Process", [&] {
+    writer.beginObject();
+    writer.members(
+        process,
+        {{"Scenes", [&] { entities(scenes); }},
+         {"Transitions", [&] { entities(transitions); }}});
+    writer.endObject();
+  }}});
+  writer.endObject();
+}
+
+QStringList DocumentSnapshot::resources() const
+{
+  QStringList res;
+  for (const auto& scene : scenes)
+    res += scene->resources;
+  for (const auto& trans : transitions)
+    res += trans->resources;
+  return res;
+}
+
+SnapshotBuilder::SnapshotBuilder(
+    const score::Document& doc,
+    const ProcessModel& process)
+    : m_document{doc}, m_process{process}
+{
+  for (const auto& scene : process.scenes)
+    on_sceneAdded(scene);
+  for (const auto& trans : process.transitions)
+    on_transitionAdded(trans);
+
+  process.scenes.added.connect<&SnapshotBuilder::on_sceneAdded>(this);
+  process.scenes.added_range.connect<&SnapshotBuilder::on_scenesAdded>(this);
+  process.scenes.removing.connect<&SnapshotBuilder::on_sceneRemoving>(this);
+  process.transitions.added.connect<&SnapshotBuilder::on_transitionAdded>(
+      this);
+  process.transitions.added_range
+      .connect<&SnapshotBuilder::on_transitionsAdded>(this);
+  process.transitions.removing
+      .connect<&SnapshotBuilder::on_transitionRemoving>(this);
+}
+
+SnapshotBuilder::~SnapshotBuilder() {}
+
+std::shared_ptr<const DocumentSnapshot> SnapshotBuilder::snapshot()
+{
+  auto snap = std::make_shared<DocumentSnapshot>();
+  snap->document = documentEnvelope();
+
+  // Same order as when serializing the process
+  snap->scenes.reserve(m_process.scenes.size());
+  for (const auto& scene : m_process.scenes)
+  {
+    auto& tracker = *m_scenes.at(&scene);
+    if (tracker.snapshot && imageSizeChanged(*tracker.snapshot, scene))
+      tracker.touch();
+    if (!tracker.snapshot)
+      tracker.snapshot = makeSnapshot(scene);
+    snap->scenes.push_back(tracker.snapshot);
+  }
+
+  snap->transitions.reserve(m_process.transitions.size());
+  for (const auto& trans : m_process.transitions)
+  {
+    auto& tracker = *m_transitions.at(&trans);
+    if (!tracker.snapshot)
+      tracker.snapshot = makeSnapshot(trans);
+    snap->transitions.push_back(tracker.snapshot);
+  }
+
+  return snap;
+}
+
+QJsonObject SnapshotBuilder::documentEnvelope() const
+{
+  // Same as score::Document::saveAsJson, without the process content.
+  QJsonObject complete, json_plugins;
+  for (const auto& plugin : m_document.model().pluginModels())
+  {
+    if (auto serializable_plugin
+        = qobject_cast<score::SerializableDocumentPlugin*>(plugin))
+    {
+      JSONObject::Serializer s_before;
+      s_before.readFrom(*serializable_plugin);
+
+      JSONObject::Serializer s_after;
+      serializable_plugin->serializeAfterDocument(s_after.toVariant());
+
+      s_before.obj["DocumentPostModelPart"] = std::move(s_after.obj);
+      json_plugins[serializable_plugin->objectName()]
+          = std::move(s_before.obj);
+    }
+  }
+
+  JSONObject::Serializer process;
+  TSerializer<JSONObject, score::Entity<ProcessModel>>::readFrom(
+      process, m_process);
+
+  JSONObject::Serializer doc;
+  TSerializer<JSONObject, IdentifiedObject<score::DocumentDelegateModel>>::
+      readFrom(doc, m_document.model().modelDelegate());
+  doc.obj["Process"] = std::move(process.obj);
+
+  complete["Plugins"] = json_plugins;
+  complete["Document"] = std::move(doc.obj);
+  complete["Version"]
+      = m_document.context().app.applicationSettings.saveFormatVersion.value();
+  return complete;
+}
+
+void SnapshotBuilder::on_sceneAdded(const SceneModel& scene)
+{
+  auto tracker = std::make_unique<SnapshotTracker>();
+  tracker->watchScene(scene);
+  m_scenes[&scene] = std::move(tracker);
+}
+
+void SnapshotBuilder::on_scenesAdded(const std::vector<SceneModel*>& scenes)
+{
+  for (auto scene : scenes)
+    on_sceneAdded(*scene);
+}
+
+void SnapshotBuilder::on_sceneRemoving(const SceneModel& scene)
+{
+  m_scenes.erase(&scene);
+}
+
+void SnapshotBuilder::on_transitionAdded(const TransitionModel& trans)
+{
+  auto tracker = std::make_unique<SnapshotTracker>();
+  tracker->watchEntity(trans);
+  m_transitions[&trans] = std::move(tracker);
+}
+
+void SnapshotBuilder::on_transitionsAdded(
+    const std::vector<TransitionModel*>& trans)
+{
+  for (auto t : trans)
+    on_transitionAdded(*t);
+}
+
+void SnapshotBuilder::on_transitionRemoving(const TransitionModel& trans)
+{
+  m_transitions.erase(&trans);
+}
+
+SnapshotWriter::SnapshotWriter(
+    std::shared_ptr<const DocumentSnapshot> snapshot,
+    QString path)
+    : m_snapshot{std::move(snapshot)}, m_path{std::move(path)}
+{
+  setAutoDelete(false);
+}
+
+SnapshotWriter::~SnapshotWriter() {}
+
+void SnapshotWriter::start()
+{
+  // Queued: the writer lives in the GUI thread.
+  connect(this, &SnapshotWriter::finished, this, &QObject::deleteLater);
+  QThreadPool::globalInstance()->start(this);
+}
+
+void SnapshotWriter::run()
+{
+  QSaveFile f{m_path};
+  const bool ok = f.open(QIODevice::WriteOnly) && m_snapshot->write(f)
+                  && f.commit();
+  finished(ok);
+}
+} // namespace SEGMent
+
+W_OBJECT_IMPL(SEGMent::SnapshotTracker)
+W_OBJECT_IMPL(SEGMent::SnapshotWriter)
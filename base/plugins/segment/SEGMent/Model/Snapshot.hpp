@@ -0,0 +1,152 @@
+#pragma once
+#include <ossia/detail/ptr_set.hpp>
+
+#include <QByteArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QObject>
+#include <QRunnable>
+#include <QStringList>
+
+#include <nano_observer.hpp>
+#include <verdigris>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class JSONStreamWriter;
+class QIODevice;
+namespace score
+{
+class Document;
+}
+namespace SEGMent
+{
+class ProcessModel;
+class SceneModel;
+class TransitionModel;
+class SnapshotTracker;
+
+/**
+ * @brief Immutable state of a scene with its objects, or of a transition.
+ *
+ * Only holds values, so that it can be read from any thread; its text is
+ * formatted once, under a lock.
+ */
+struct EntitySnapshot
+{
+  int32_t id{};
+
+  //! Serialized form, as saved in the .segment files.
+  QJsonObject json;
+
+  //! Files used by the entity, e.g. images and sounds.
+  //! They are relative to the document folder unless absolute.
+  QStringList resources;
+
+  //! The text of json as the writer would write it at its position.
+  //! It is kept, so that the entities which did not change are only
+  //! formatted once across snapshots and saves.
+  QByteArray text(const JSONStreamWriter& writer) const;
+
+private:
+  struct Text
+  {
+    std::size_t depth{};
+    QByteArray text;
+  };
+
+  // Indented and compact
+  mutable Text m_text[2];
+  mutable std::mutex m_textMutex;
+};
+
+/**
+ * @brief Immutable state of a whole SEGMent document.
+ *
+ * Successive snapshots of a document share the scenes and transitions
+ * which did not change in-between.
+ */
+struct DocumentSnapshot
+{
+  //! The saved document, without the scenes and the transitions.
+  QJsonObject document;
+  std::vector<std::shared_ptr<const EntitySnapshot>> scenes;
+  std::vector<std::shared_ptr<const EntitySnapshot>> transitions;
+
+  //! Writes the same text as score::Document::saveAsJson.
+  //! Returns false if the device could not be written to.
+  bool write(
+      QIODevice& device,
+      QJsonDocument::JsonFormat format = QJsonDocument::Indented) const;
+
+  //! Writes the "Document" member, as DocumentModel::serializeJson.
+  void writeDocument(JSONStreamWriter& writer) const;
+
+  //! All the files used by the document.
+  QStringList resources() const;
+};
+
+/**
+ * @brief Takes snapshots of a document.
+ *
+ * The changes to the scenes, their objects and the transitions are tracked,
+ * so that taking a snapshot only serializes what changed since the previous
+ * one.
+ *
+ * Must be used from the GUI thread; the snapshots can then be read from
+ * any thread while the model keeps being edited.
+ */
+class SnapshotBuilder final : public Nano::Observer
+{
+public:
+  SnapshotBuilder(const score::Document& doc, const ProcessModel& process);
+  ~SnapshotBuilder();
+
+  std::shared_ptr<const DocumentSnapshot> snapshot();
+
+private:
+  void on_sceneAdded(const SceneModel& scene);
+  void on_scenesAdded(const std::vector<SceneModel*>& scenes);
+  void on_sceneRemoving(const SceneModel& scene);
+  void on_transitionAdded(const TransitionModel& trans);
+  void on_transitionsAdded(const std::vector<TransitionModel*>& trans);
+  void on_transitionRemoving(const TransitionModel& trans);
+
+  QJsonObject documentEnvelope() const;
+
+  const score::Document& m_document;
+  const ProcessModel& m_process;
+  ossia::ptr_map<const SceneModel*, std::unique_ptr<SnapshotTracker>>
+      m_scenes;
+  ossia::ptr_map<const TransitionModel*, std::unique_ptr<SnapshotTracker>>
+      m_transitions;
+};
+
+/**
+ * @brief Writes a snapshot to a file from a worker thread.
+ */
+class SnapshotWriter final : public QObject, public QRunnable
+{
+  W_OBJECT(SnapshotWriter)
+public:
+  SnapshotWriter(
+      std::shared_ptr<const DocumentSnapshot> snapshot,
+      QString path);
+  ~SnapshotWriter() override;
+
+  //! Runs in the global thread pool.
+  //! The writer deletes itself once finished has been sent.
+  void start();
+
+  void run() override;
+
+  //! Sent from the worker thread.
+  void finished(bool ok) W_SIGNAL(finished, ok);
+
+private:
+  std::shared_ptr<const DocumentSnapshot> m_snapshot;
+  QString m_path;
+};
+} // namespace SEGMent
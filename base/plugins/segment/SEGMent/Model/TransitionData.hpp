@@ -3,6 +3,7 @@
 #include <score/model/path/Path.hpp>
 #include <SEGMent/Items/Anchor.hpp>
 #include <SEGMent/Model/Riddle.hpp>
+#include <SEGMent/StringUtils.hpp>
 
 namespace SEGMent
 {
@@ -104,14 +105,18 @@ struct TSerializer<DataStream, SEGMent::Transition<T, U>>
   readFrom(DataStream::Serializer& s, const SEGMent::Transition<T, U>& v)
   {
     auto& st = s.stream();
-    st << v.from << v.to << v.source << v.target;
+    SEGMent::writeCompactPath(st.stream, v.from);
+    SEGMent::writeCompactPath(st.stream, v.to);
+    st << v.source << v.target;
   }
 
   static void
   writeTo(DataStream::Deserializer& s, SEGMent::Transition<T, U>& v)
   {
     auto& st = s.stream();
-    st >> v.from >> v.to >> v.source >> v.target;
+    SEGMent::readCompactPath(st.stream, v.from);
+    SEGMent::readCompactPath(st.stream, v.to);
+    st >> v.source >> v.target;
   }
 };
 
@@ -146,13 +151,17 @@ struct TSerializer<
   static void readFrom(DataStream::Serializer& s, const type& v)
   {
     auto& st = s.stream();
-    st << v.from << v.to << v.source << v.target << v.riddle;
+    SEGMent::writeCompactPath(st.stream, v.from);
+    SEGMent::writeCompactPath(st.stream, v.to);
+    st << v.source << v.target << v.riddle;
   }
 
   static void writeTo(DataStream::Deserializer& s, type& v)
   {
     auto& st = s.stream();
-    st >> v.from >> v.to >> v.source >> v.target >> v.riddle;
+    SEGMent::readCompactPath(st.stream, v.from);
+    SEGMent::readCompactPath(st.stream, v.to);
+    st >> v.source >> v.target >> v.riddle;
   }
 };
 
@@ -3,6 +3,7 @@
 #include <SEGMent/Commands/Creation.hpp>
 
 #include <core/document/Document.hpp>
+#include <score/command/Dispatchers/CommandDispatcher.hpp>
 
 #include <QMimeData>
 #include <QJsonDocument>
@@ -57,8 +58,8 @@ struct ObjectPaster
     const auto& docResources = obj["Resources"].toArray();
     copyResources(QFileInfo{docPath}.absolutePath(), QFileInfo{doc.metadata().fileName()}.absolutePath(), docResources);
 
-    std::vector<Id<SceneModel>> ids;
-    for(auto& scene : proc.scenes) ids.push_back(scene.id());
+    // The pasted scenes get consecutive ids after the existing ones
+    int32_t next_id = getStrongId(proc.scenes).val();
 
     std::unordered_map<QString, Id<SceneModel>> id_map;
 
@@ -71,9 +72,7 @@ struct ObjectPaster
       auto path = scene["Path"].toString();
 
       // Also generate new ids for the scenes
-      auto new_id = getStrongId(ids);
-      id_map[path] = new_id;
-      ids.push_back(new_id);
+      id_map[path] = Id<SceneModel>{next_id++};
 
       auto rect = fromJsonValue<QRectF>(scene["Rect"]);
       if(rect.x() < topLeft.x()) topLeft.setX(rect.x());
@@ -83,8 +82,9 @@ struct ObjectPaster
     }
     const QPointF orig_center = QRectF(topLeft, bottomRight).center();
 
-    // Create all the commands
-    RedoMacroCommandDispatcher<PasteScenes> disp{doc.context().commandStack};
+    // Move the scenes around the paste position
+    std::vector<Id<SceneModel>> scene_ids;
+    std::vector<QJsonObject> scenes;
     for(auto scene_ref : obj["Scenes"].toArray())
     {
       auto scene = scene_ref.toObject();
@@ -95,12 +95,16 @@ struct ObjectPaster
             QRectF{rect.x() - orig_center.x() + scene_pos.x(),
                    rect.y() - orig_center.y() + scene_pos.y(),
                    rect.width(), rect.height()});
-      disp.submitCommand(new PasteScene{proc, scene, id_map.at(path)});
+      scene_ids.push_back(id_map.at(path));
+      scenes.push_back(std::move(scene));
     }
 
     // This is the complicated part : we have to adjust the paths stored in the
     // transitions, so that they point to the pasted objects instead of the original ones.
     // This means that we have to mess with the JSON data a little bit.
+    // The pasted scenes do not exist yet, so their paths are built from their new ids.
+    const Path<ProcessModel> proc_path{proc};
+    std::vector<QJsonObject> transitions;
     for(auto transition_ref : obj["Transitions"].toArray())
     {
       auto transition = transition_ref.toObject();
@@ -108,13 +112,13 @@ struct ObjectPaster
       auto which_trans = trans_sub["Which"].toString();
       auto trans_object = trans_sub[which_trans].toObject();
       auto to = trans_object["To"].toString();
-      auto to_newPath = pathToString(Path{proc.scenes.at(id_map[to])});
+      auto to_newPath = pathToString(proc_path.extend(id_map[to]));
       trans_object["To"] = to_newPath;
 
       if(which_trans == "SceneToScene")
       {
         auto from = trans_object["From"].toString();
-        auto from_newPath = pathToString(Path{proc.scenes.at(id_map[from])});
+        auto from_newPath = pathToString(proc_path.extend(id_map[from]));
         trans_object["From"] = from_newPath;
       }
       else
@@ -122,17 +126,19 @@ struct ObjectPaster
         auto from = trans_object["From"].toString();
         auto object_from = from.mid(from.lastIndexOf('/'));
         auto scene_from = from.mid(0, from.lastIndexOf('/'));
-        auto from_newPath = pathToString(Path{proc.scenes.at(id_map[scene_from])}) + object_from;
+        auto from_newPath = pathToString(proc_path.extend(id_map[scene_from])) + object_from;
         trans_object["From"] = from_newPath;
       }
 
       trans_sub[which_trans] = trans_object;
       transition["Transition"] = trans_sub;
 
-      disp.submitCommand(new PasteTransition{proc, transition});
+      transitions.push_back(std::move(transition));
     }
 
-    disp.commit();
+    CommandDispatcher<> disp{doc.context().commandStack};
+    disp.submitCommand(new PasteSceneGroup{
+        proc, std::move(scene_ids), std::move(scenes), std::move(transitions)});
   }
 
   /**
@@ -152,7 +158,9 @@ struct ObjectPaster
         return;
     }
 
-    auto& scene = static_cast<SceneWindow*>(item_under_mouse)->model();
+    auto& window = *static_cast<SceneWindow*>(item_under_mouse);
+    window.loadChildren();
+    auto& scene = window.model();
 
     auto item_pos = item_under_mouse->mapFromScene(scene_pos);
     QPointF relative_item_pos = {
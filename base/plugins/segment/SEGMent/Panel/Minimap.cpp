@@ -1,21 +1,270 @@
+#include <score/tools/Todo.hpp>
+
 #include <core/document/Document.hpp>
 #include <core/document/DocumentModel.hpp>
+#include <core/document/DocumentView.hpp>
 
+#include <QMouseEvent>
+#include <QPainter>
 #include <QVBoxLayout>
 
 #include <SEGMent/Document.hpp>
+#include <SEGMent/FilePath.hpp>
+#include <SEGMent/ImageCache.hpp>
+#include <SEGMent/Model/Layer/ProcessView.hpp>
 #include <SEGMent/Model/ProcessModel.hpp>
 #include <SEGMent/Panel/Minimap.hpp>
+#include <wobjectimpl.h>
 W_OBJECT_IMPL(SEGMent::Minimap)
 namespace SEGMent
 {
+//! Minimum delay between two refits of the minimap, in milliseconds.
+static constexpr int minimapUpdateInterval = 50;
+
+MinimapSceneItem::MinimapSceneItem(
+    const SceneModel& scene,
+    const score::DocumentContext& ctx)
+    : m_scene{scene}, m_context{ctx}
+{
+  setFlag(ItemIsSelectable, false);
+  setAcceptedMouseButtons(Qt::NoButton);
+  updateImage();
+  updateRect();
+}
+
+void MinimapSceneItem::updateRect()
+{
+  const auto& r = m_scene.rect();
+  if (r.size() != m_size)
+  {
+    prepareGeometryChange();
+    m_size = r.size();
+  }
+  setPos(r.topLeft());
+}
+
+void MinimapSceneItem::updateImage()
+{
+  m_pixmap = ImageCache::instance().small(
+      QFileInfo{toLocalFile(m_scene.image().path, m_context)});
+  update();
+}
+
+QRectF MinimapSceneItem::boundingRect() const
+{
+  return {0., 0., m_size.width(), m_size.height()};
+}
+
+void MinimapSceneItem::paint(
+    QPainter* painter,
+    const QStyleOptionGraphicsItem* option,
+    QWidget* widget)
+{
+  const auto rect = boundingRect();
+  painter->drawPixmap(rect, m_pixmap, QRectF{m_pixmap.rect()});
+
+  static const QPen& pen = Style::instance().sceneBorderPen;
+  painter->setPen(pen);
+  painter->setBrush(Qt::NoBrush);
+  painter->drawRect(rect);
+}
+
+MinimapScene::MinimapScene(
+    const ProcessModel& process,
+    const score::DocumentContext& ctx,
+    QObject* parent)
+    : QGraphicsScene{parent}, m_context{ctx}
+{
+  QPen viewportPen{Qt::red, 2};
+  viewportPen.setCosmetic(true);
+  m_viewportItem.setPen(viewportPen);
+  m_viewportItem.setZValue(1);
+  m_viewportItem.setVisible(false);
+  addItem(&m_viewportItem);
+
+  m_updateTimer.setSingleShot(true);
+  m_updateTimer.setInterval(minimapUpdateInterval);
+  connect(&m_updateTimer, &QTimer::timeout, this, &MinimapScene::on_timeout);
+
+  for (const auto& scene : process.scenes)
+  {
+    on_sceneAdded(scene);
+  }
+
+  process.scenes.added.connect<&MinimapScene::on_sceneAdded>(this);
+  process.scenes.added_range.connect<&MinimapScene::on_scenesAdded>(this);
+  process.scenes.removed.connect<&MinimapScene::on_sceneRemoved>(this);
+}
+
+void MinimapScene::setTarget(ZoomView* view)
+{
+  if (m_target)
+    disconnect(m_target.data(), nullptr, this, nullptr);
+
+  m_target = view;
+
+  if (m_target)
+  {
+    connect(
+        m_target.data(),
+        &ZoomView::visibleRectChanged,
+        this,
+        &MinimapScene::requestUpdate);
+  }
+  requestUpdate();
+}
+
+void MinimapScene::requestUpdate()
+{
+  if (!m_updateTimer.isActive())
+    m_updateTimer.start();
+}
+
+void MinimapScene::on_sceneAdded(const SceneModel& scene)
+{
+  auto item = new MinimapSceneItem{scene, m_context};
+  m_items.insert({&scene, item});
+  addItem(item);
+
+  con(scene, &SceneModel::rectChanged, this, [this, &scene] {
+    on_sceneRectChanged(scene);
+  });
+  con(scene, &SceneModel::imageChanged, this, [this, &scene] {
+    on_sceneImageChanged(scene);
+  });
+
+  m_contentsDirty = true;
+  requestUpdate();
+}
+
+void MinimapScene::on_scenesAdded(const std::vector<SceneModel*>& scenes)
+{
+  // The update is deferred, so the minimap is only redrawn once.
+  for (auto scene : scenes)
+    on_sceneAdded(*scene);
+}
+
+void MinimapScene::on_sceneRemoved(const SceneModel& scene)
+{
+  auto it = m_items.find(&scene);
+  if (it != m_items.end())
+  {
+    delete it->second;
+    m_items.erase(it);
+  }
+
+  disconnect(&scene, nullptr, this, nullptr);
+
+  m_contentsDirty = true;
+  requestUpdate();
+}
+
+void MinimapScene::on_sceneRectChanged(const SceneModel& scene)
+{
+  auto it = m_items.find(&scene);
+  if (it != m_items.end())
+  {
+    it->second->updateRect();
+    m_contentsDirty = true;
+    requestUpdate();
+  }
+}
+
+void MinimapScene::on_sceneImageChanged(const SceneModel& scene)
+{
+  auto it = m_items.find(&scene);
+  if (it != m_items.end())
+  {
+    it->second->updateImage();
+  }
+}
+
+void MinimapScene::on_timeout()
+{
+  if (m_contentsDirty)
+  {
+    m_contentsRect = {};
+    for (const auto& [scene, item] : m_items)
+    {
+      m_contentsRect |= item->mapRectToScene(item->boundingRect());
+    }
+    m_contentsDirty = false;
+  }
+
+  QRectF visible;
+  if (m_target)
+  {
+    visible = m_target->mapToScene(m_target->viewport()->rect())
+                  .boundingRect();
+    m_viewportItem.setRect(visible);
+    m_viewportItem.setVisible(true);
+  }
+  else
+  {
+    m_viewportItem.setVisible(false);
+  }
+
+  // Frame the scenes and the part of the canvas that is currently shown
+  const auto frame = m_contentsRect.isEmpty() ? visible : m_contentsRect | visible;
+  if (frame.isEmpty())
+    return;
+
+  const auto margin = 0.05 * std::max(frame.width(), frame.height());
+  const auto framed = frame.adjusted(-margin, -margin, margin, margin);
+  setSceneRect(framed);
+  for (auto view : views())
+  {
+    view->fitInView(framed, Qt::KeepAspectRatio);
+  }
+}
+
+void MinimapView::mousePressEvent(QMouseEvent* event)
+{
+  if (event->button() == Qt::LeftButton)
+    navigate(event->pos());
+  event->accept();
+}
+
+void MinimapView::mouseMoveEvent(QMouseEvent* event)
+{
+  if (event->buttons() & Qt::LeftButton)
+    navigate(event->pos());
+  event->accept();
+}
+
+void MinimapView::resizeEvent(QResizeEvent* event)
+{
+  QGraphicsView::resizeEvent(event);
+  if (auto s = static_cast<MinimapScene*>(scene()))
+    s->requestUpdate();
+}
+
+void MinimapView::navigate(QPoint pos)
+{
+  auto s = static_cast<MinimapScene*>(scene());
+  if (!s)
+    return;
+
+  if (auto target = s->target())
+  {
+    target->centerOn(mapToScene(pos));
+  }
+}
+
 Minimap::Minimap(const score::GUIApplicationContext& ctx)
     : score::PanelDelegate{ctx}
     , m_widget{new QWidget}
-    , m_scene{new QGraphicsScene{m_widget}}
-    , m_view{new QGraphicsView{m_widget}}
+    , m_view{new MinimapView{m_widget}}
 {
-  m_widget->setLayout(new QVBoxLayout);
+  auto lay = new QVBoxLayout{m_widget};
+  lay->setContentsMargins(0, 0, 0, 0);
+  lay->addWidget(m_view);
+
+  m_view->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+  m_view->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+  m_view->setRenderHint(QPainter::SmoothPixmapTransform);
+  m_view->setBackgroundBrush(Style::instance().backgroundBrush);
+  m_view->setCursor(Qt::PointingHandCursor);
 }
 
 QWidget* Minimap::widget()
@@ -29,7 +278,7 @@ const score::PanelStatus& Minimap::defaultPanelStatus() const
                                          Qt::RightDockWidgetArea,
                                          100,
                                          QObject::tr("Navigation"),
-                                         QObject::tr("Ctrl+N")};
+                                         QObject::tr("Ctrl+Shift+N")};
 
   return status;
 }
@@ -38,22 +287,32 @@ void Minimap::on_modelChanged(
     score::MaybeDocument oldm,
     score::MaybeDocument newm)
 {
+  m_view->setScene(nullptr);
   delete m_scene;
-  m_scene = new QGraphicsScene{this};
-  m_view->setScene(m_scene);
+  m_scene = nullptr;
 
   if (newm)
   {
     if (auto d = dynamic_cast<DocumentModel*>(
             &newm->document.model().modelDelegate()))
     {
-      for (auto& scene : d->process().scenes)
+      m_scene = new MinimapScene{d->process(), *newm, this};
+      m_view->setScene(m_scene);
+
+      if (auto v = newm->document.view())
       {
-        auto pix = m_scene->addPixmap(scene.image().path);
-        pix->setPos(scene.rect().topLeft());
+        if (auto dv = dynamic_cast<DocumentView*>(&v->viewDelegate()))
+        {
+          m_scene->setTarget(&dv->view());
+        }
       }
     }
   }
 }
 
+std::unique_ptr<score::PanelDelegate>
+MinimapFactory::make(const score::GUIApplicationContext& ctx)
+{
+  return std::make_unique<Minimap>(ctx);
+}
 } // namespace SEGMent
@@ -2,12 +2,96 @@
 #include <score/plugins/panel/PanelDelegate.hpp>
 #include <score/plugins/panel/PanelDelegateFactory.hpp>
 
+#include <ossia/detail/ptr_set.hpp>
+
+#include <QGraphicsRectItem>
 #include <QGraphicsScene>
 #include <QGraphicsView>
+#include <QPixmap>
+#include <QPointer>
+#include <QTimer>
+
+#include <nano_observer.hpp>
 
 namespace SEGMent
 {
+class ProcessModel;
+class SceneModel;
+class ZoomView;
+
+//! Thumbnail of a SEGMent scene in the minimap.
+//! Uses the small version of the background from the ImageCache.
+class MinimapSceneItem final : public QGraphicsItem
+{
+public:
+  MinimapSceneItem(
+      const SceneModel& scene,
+      const score::DocumentContext& ctx);
+
+  void updateRect();
+  void updateImage();
+
+  QRectF boundingRect() const override;
+  void paint(
+      QPainter* painter,
+      const QStyleOptionGraphicsItem* option,
+      QWidget* widget) override;
+
+private:
+  const SceneModel& m_scene;
+  const score::DocumentContext& m_context;
+  QPixmap m_pixmap;
+  QSizeF m_size;
+};
+
+//! Contents of the minimap for a given document.
+//! Follows the scenes of the process incrementally and coalesces
+//! the refits of the view through a timer.
+class MinimapScene final : public QGraphicsScene, public Nano::Observer
+{
+public:
+  MinimapScene(
+      const ProcessModel& process,
+      const score::DocumentContext& ctx,
+      QObject* parent);
+
+  void setTarget(ZoomView* view);
+  ZoomView* target() const noexcept { return m_target; }
+
+  //! Schedules an update of the viewport rectangle and of the framing.
+  void requestUpdate();
+
+private:
+  void on_sceneAdded(const SceneModel& scene);
+  void on_scenesAdded(const std::vector<SceneModel*>& scenes);
+  void on_sceneRemoved(const SceneModel& scene);
+  void on_sceneRectChanged(const SceneModel& scene);
+  void on_sceneImageChanged(const SceneModel& scene);
+  void on_timeout();
+
+  const score::DocumentContext& m_context;
+  ossia::ptr_map<const SceneModel*, MinimapSceneItem*> m_items;
+  QGraphicsRectItem m_viewportItem;
+  QPointer<ZoomView> m_target;
+  QRectF m_contentsRect;
+  QTimer m_updateTimer;
+  bool m_contentsDirty{true};
+};
+
+//! Shows the minimap and centers the canvas on the position clicked.
+class MinimapView final : public QGraphicsView
+{
+public:
+  using QGraphicsView::QGraphicsView;
+
+private:
+  void mousePressEvent(QMouseEvent* event) override;
+  void mouseMoveEvent(QMouseEvent* event) override;
+  void resizeEvent(QResizeEvent* event) override;
+  void navigate(QPoint pos);
+};
 
+//! Navigation panel of SEGMent
 class Minimap final : public QObject, public score::PanelDelegate
 {
   W_OBJECT(Minimap)
@@ -21,8 +105,8 @@ private:
       override;
 
   QWidget* m_widget{};
-  QGraphicsScene* m_scene{};
-  QGraphicsView* m_view{};
+  MinimapScene* m_scene{};
+  MinimapView* m_view{};
 };
 
 class MinimapFactory final : public score::PanelDelegateFactory
@@ -0,0 +1,174 @@
+#include <QGraphicsItem>
+#include <QGraphicsScene>
+#include <QPainter>
+#include <QPixmapCache>
+
+#include <SEGMent/Items/GlobalVariables.hpp>
+#include <SEGMent/Model/Layer/ProcessView.hpp>
+#include <SEGMent/RenderCachePolicy.hpp>
+
+#include <cmath>
+
+namespace SEGMent
+{
+namespace
+{
+// Keys of the QGraphicsItem::data used to store the state of the policy
+constexpr int kindKey = 0x5E6C0;
+constexpr int costKey = 0x5E6C1;
+
+// Bytes per pixel of the item caches
+constexpr qint64 pixelSize = 4;
+
+// Size of the cache pixmaps that Qt keeps for its own use, in KB
+constexpr int qtPixmapCacheSize = 10240;
+
+bool isRasterized(const QGraphicsItem& item)
+{
+  const auto kind = item.data(kindKey);
+  return kind.isValid() && kind.toInt() >= RenderCachePolicy::Text;
+}
+
+//! Scale between item coordinates and device pixels for the settled zoom
+//! level of the view which shows the item.
+qreal deviceScale(const QGraphicsItem& item)
+{
+  qreal zoom = 1.;
+  if (auto scene = item.scene())
+  {
+    for (auto view : scene->views())
+    {
+      if (auto zv = qobject_cast<ZoomView*>(view))
+      {
+        zoom = zv->cacheZoomLevel() * zv->devicePixelRatioF();
+        break;
+      }
+    }
+  }
+
+  return zoom * std::sqrt(std::abs(item.sceneTransform().determinant()));
+}
+} // namespace
+
+RenderCachePolicy::RenderCachePolicy()
+{
+  setBudget(defaultBudget);
+}
+
+qreal RenderCachePolicy::cacheZoomLevel(qreal zoom) noexcept
+{
+  // Round up so that the caches are never shown magnified once settled
+  return std::exp2(
+      std::ceil(std::log2(zoom) * stepsPerOctave) / stepsPerOctave);
+}
+
+void RenderCachePolicy::setBudget(qint64 bytes)
+{
+  m_budget = bytes;
+
+  // Item caches are stored in the QPixmapCache: it must be able to
+  // hold the whole budget, or the caches would be evicted and rasterized
+  // again at each frame.
+  QPixmapCache::setCacheLimit(int(bytes / 1024) + qtPixmapCacheSize);
+}
+
+void RenderCachePolicy::setKind(QGraphicsItem& item, ItemKind kind)
+{
+  release(item);
+  item.setData(kindKey, int(kind));
+
+  switch (kind)
+  {
+    case Fill:
+    case Line:
+      item.setCacheMode(QGraphicsItem::NoCache);
+      break;
+    case Fixed:
+      item.setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+      break;
+    case Text:
+    case Image:
+      rasterize(item);
+      break;
+  }
+}
+
+void RenderCachePolicy::update(QGraphicsItem& item)
+{
+  if (isRasterized(item))
+    rasterize(item);
+}
+
+void RenderCachePolicy::updateTree(QGraphicsItem& item)
+{
+  update(item);
+  for (auto child : item.childItems())
+    updateTree(*child);
+}
+
+void RenderCachePolicy::updateScene(QGraphicsScene& scene)
+{
+  // Free all the caches of the scene first so that the budget is
+  // distributed again from scratch.
+  const auto items = scene.items();
+  for (auto item : items)
+  {
+    if (isRasterized(*item))
+    {
+      m_used -= item->data(costKey).toLongLong();
+      item->setData(costKey, 0);
+    }
+  }
+
+  for (auto item : items)
+    update(*item);
+}
+
+void RenderCachePolicy::release(QGraphicsItem& item) noexcept
+{
+  m_used -= item.data(costKey).toLongLong();
+  item.setData(costKey, 0);
+}
+
+void RenderCachePolicy::rasterize(QGraphicsItem& item)
+{
+  release(item);
+
+  QSizeF size = item.boundingRect().size() * deviceScale(item);
+  if (size.width() > maxCacheSize || size.height() > maxCacheSize)
+    size.scale(maxCacheSize, maxCacheSize, Qt::KeepAspectRatio);
+
+  const QSize pixels{int(std::ceil(size.width())),
+                     int(std::ceil(size.height()))};
+  const qint64 cost = pixelSize * pixels.width() * pixels.height();
+  if (pixels.isEmpty() || m_used + cost > m_budget)
+  {
+    item.setCacheMode(QGraphicsItem::NoCache);
+    return;
+  }
+
+  // Does nothing if the cache already has this size.
+  item.setCacheMode(QGraphicsItem::ItemCoordinateCache, pixels);
+  item.setData(costKey, cost);
+  m_used += cost;
+}
+
+const QPixmap& RenderCachePolicy::backgroundTile(qreal devicePixelRatio)
+{
+  if (m_backgroundTile.isNull()
+      || m_backgroundTile.devicePixelRatioF() != devicePixelRatio)
+  {
+    const int size = std::ceil(backgroundTileSize * devicePixelRatio);
+    m_backgroundTile = QPixmap{size, size};
+    m_backgroundTile.setDevicePixelRatio(devicePixelRatio);
+    m_backgroundTile.fill(Style::instance().backgroundBrush.color());
+
+    QBrush b = Style::instance().backgroundPen;
+    b.setTransform(QTransform::fromScale(2, 2));
+
+    QPainter p{&m_backgroundTile};
+    p.fillRect(QRectF{0, 0, backgroundTileSize, backgroundTileSize}, b);
+  }
+  return m_backgroundTile;
+}
+} // namespace SEGMent
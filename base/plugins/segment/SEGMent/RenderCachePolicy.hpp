@@ -0,0 +1,86 @@
+#pragma once
+#include <QPixmap>
+#include <QSize>
+
+class QGraphicsItem;
+class QGraphicsScene;
+namespace SEGMent
+{
+/**
+ * @brief The RenderCachePolicy class
+ *
+ * Chooses how each kind of item of the canvas is cached:
+ *
+ * - Fill: plain rectangles, cheaper to fill again than to blit: not cached.
+ * - Line: arrows, a few pixels spread over large bounds: not cached.
+ * - Fixed: items which ignore the zoom (anchors): cached in device
+ *   coordinates, zooming only moves them.
+ * - Text, Image: cached in item coordinates, at a resolution which follows
+ *   the zoom level of the view by steps. While a zoom is in progress, the
+ *   existing caches are scaled; they are only rasterized again once the
+ *   zoom has settled on a different step.
+ *
+ * The memory used by the caches of the last two kinds is accounted for
+ * against a budget shared by all the documents: items which do not fit
+ * are drawn directly.
+ */
+class RenderCachePolicy
+{
+public:
+  enum ItemKind
+  {
+    Fill,
+    Line,
+    Fixed,
+    Text,
+    Image
+  };
+
+  //! Number of cache resolutions for each doubling of the zoom.
+  static constexpr int stepsPerOctave = 2;
+  //! Largest side of an item cache, in pixels.
+  static constexpr int maxCacheSize = 4096;
+  //! Default memory budget for the item caches, in bytes.
+  static constexpr qint64 defaultBudget = 256ll * 1024 * 1024;
+  //! Size of the background tiles, in pixels.
+  //! Must be a multiple of the period of the background pattern.
+  static constexpr int backgroundTileSize = 256;
+
+  static RenderCachePolicy& instance() noexcept
+  {
+    static RenderCachePolicy p;
+    return p;
+  }
+
+  //! Zoom level at which the caches are rasterized for a given zoom.
+  static qreal cacheZoomLevel(qreal zoom) noexcept;
+
+  qint64 budget() const noexcept { return m_budget; }
+  qint64 used() const noexcept { return m_used; }
+  void setBudget(qint64 bytes);
+
+  //! Sets the cache mode of an item according to its kind.
+  void setKind(QGraphicsItem& item, ItemKind kind);
+
+  //! To be called when the geometry or the scale of an item changes.
+  void update(QGraphicsItem& item);
+  //! Updates an item and all its children.
+  void updateTree(QGraphicsItem& item);
+  //! Updates all the items of a scene, e.g. when the zoom level has changed.
+  void updateScene(QGraphicsScene& scene);
+
+  //! To be called when an item whose kind has been set is destroyed.
+  void release(QGraphicsItem& item) noexcept;
+
+  //! Tile of the background pattern, in device pixels.
+  const QPixmap& backgroundTile(qreal devicePixelRatio);
+
+private:
+  RenderCachePolicy();
+  void rasterize(QGraphicsItem& item);
+
+  qint64 m_budget{};
+  qint64 m_used{};
+  QPixmap m_backgroundTile;
+};
+} // namespace SEGMent
@@ -0,0 +1,146 @@
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+#include <SEGMent/ImageCache.hpp>
+#include <SEGMent/RenderProfiler.hpp>
+
+namespace SEGMent
+{
+const char* RenderProfiler::className(ItemClass c) noexcept
+{
+  switch (c)
+  {
+    case SceneWindow:
+      return "SceneWindow";
+    case ImageWindow:
+      return "ImageWindow";
+    case Arrow:
+      return "Arrow";
+    case Anchor:
+      return "Anchor";
+    case LODPixmapItem:
+      return "LODPixmapItem";
+    default:
+      return "";
+  }
+}
+
+void RenderProfiler::setEnabled(bool b)
+{
+  if (b == m_enabled)
+    return;
+
+  m_enabled = b;
+  if (b)
+  {
+    m_frames.clear();
+    m_current = {};
+    m_enableTime = clock::now();
+  }
+}
+
+void RenderProfiler::beginFrame()
+{
+  m_current = {};
+  m_frameStart = clock::now();
+}
+
+void RenderProfiler::endFrame(int visibleItems, int totalItems)
+{
+  using namespace std::chrono;
+  const auto now = clock::now();
+  m_current.timestamp
+      = duration_cast<milliseconds>(m_frameStart - m_enableTime).count();
+  m_current.frameTime = duration_cast<nanoseconds>(now - m_frameStart).count();
+  m_current.visibleItems = visibleItems;
+  m_current.totalItems = totalItems;
+
+  if (ImageCache::self)
+  {
+    const auto& stats = ImageCache::instance().statistics();
+    m_current.cacheHits = stats.hits;
+    m_current.cacheMisses = stats.misses;
+  }
+
+  if (m_frames.size() == maxFrames)
+    m_frames.pop_front();
+  m_frames.push_back(m_current);
+}
+
+QString RenderProfiler::summary() const
+{
+  if (m_frames.empty())
+    return {};
+
+  // Average over the last frames to get readable numbers
+  constexpr std::size_t window = 30;
+  const std::size_t n = std::min(window, m_frames.size());
+
+  double frameTime{};
+  std::array<double, ItemClassCount> paintTime{};
+  for (auto it = m_frames.end() - n; it != m_frames.end(); ++it)
+  {
+    frameTime += it->frameTime;
+    for (int i = 0; i < ItemClassCount; i++)
+      paintTime[i] += it->paintTime[i];
+  }
+
+  constexpr double ns_to_ms = 1e-6;
+  const auto& last = m_frames.back();
+  QString s;
+  s += QString("Frame: %1 ms\n").arg(frameTime * ns_to_ms / n, 0, 'f', 2);
+  for (int i = 0; i < ItemClassCount; i++)
+  {
+    s += QString("  %1: %2 ms (%3)\n")
+             .arg(className(ItemClass(i)))
+             .arg(paintTime[i] * ns_to_ms / n, 0, 'f', 2)
+             .arg(last.paintCount[i]);
+  }
+  s += QString("Items: %1 visible / %2\n")
+           .arg(last.visibleItems)
+           .arg(last.totalItems);
+
+  const auto lookups = last.cacheHits + last.cacheMisses;
+  const double hitRate = lookups > 0 ? 100. * last.cacheHits / lookups : 0.;
+  s += QString("ImageCache: %1 hits, %2 misses (%3 %)")
+           .arg(last.cacheHits)
+           .arg(last.cacheMisses)
+           .arg(hitRate, 0, 'f', 1);
+  return s;
+}
+
+bool RenderProfiler::saveTrace(const QString& path) const
+{
+  QJsonArray frames;
+  for (const auto& f : m_frames)
+  {
+    QJsonObject paint;
+    for (int i = 0; i < ItemClassCount; i++)
+    {
+      paint[className(ItemClass(i))] = QJsonObject{
+          {"Time", double(f.paintTime[i])}, {"Count", f.paintCount[i]}};
+    }
+
+    frames.push_back(QJsonObject{{"Timestamp", double(f.timestamp)},
+                                 {"FrameTime", double(f.frameTime)},
+                                 {"Paint", paint},
+                                 {"VisibleItems", f.visibleItems},
+                                 {"TotalItems", f.totalItems},
+                                 {"CacheHits", double(f.cacheHits)},
+                                 {"CacheMisses", double(f.cacheMisses)}});
+  }
+
+  QJsonObject trace;
+  trace["Version"] = 1;
+  trace["DurationUnit"] = "ns";
+  trace["Frames"] = frames;
+
+  QSaveFile f{path};
+  if (!f.open(QIODevice::WriteOnly))
+    return false;
+  f.write(QJsonDocument{trace}.toJson());
+  return f.commit();
+}
+} // namespace SEGMent
@@ -0,0 +1,114 @@
+#pragma once
+#include <QString>
+
+#include <array>
+#include <chrono>
+#include <deque>
+
+namespace SEGMent
+{
+/**
+ * @brief The RenderProfiler class
+ *
+ * Measures how long the canvas takes to draw: total frame time, and
+ * paint time for each kind of item.
+ * It is disabled by default; the instrumented paint functions then only
+ * check a boolean.
+ */
+class RenderProfiler
+{
+public:
+  enum ItemClass : int
+  {
+    SceneWindow,
+    ImageWindow,
+    Arrow,
+    Anchor,
+    LODPixmapItem,
+    ItemClassCount
+  };
+
+  //! Measurements for one paint event of the canvas.
+  struct Frame
+  {
+    //! Time since the profiler was enabled, in milliseconds.
+    qint64 timestamp{};
+    //! Durations are in nanoseconds.
+    qint64 frameTime{};
+    std::array<qint64, ItemClassCount> paintTime{};
+    std::array<int, ItemClassCount> paintCount{};
+    int visibleItems{};
+    int totalItems{};
+    //! Cumulative ImageCache statistics at the end of the frame.
+    qint64 cacheHits{};
+    qint64 cacheMisses{};
+  };
+
+  //! Times the paint function of an item while it is in scope.
+  class Scope
+  {
+  public:
+    explicit Scope(ItemClass c) noexcept
+    {
+      if (RenderProfiler::instance().enabled())
+      {
+        m_class = c;
+        m_start = clock::now();
+      }
+    }
+
+    ~Scope()
+    {
+      if (m_class != ItemClassCount)
+        RenderProfiler::instance().addPaint(m_class, clock::now() - m_start);
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+  private:
+    ItemClass m_class{ItemClassCount};
+    std::chrono::steady_clock::time_point m_start;
+  };
+
+  //! Number of frames kept for the trace.
+  static constexpr std::size_t maxFrames = 10000;
+
+  static RenderProfiler& instance() noexcept
+  {
+    static RenderProfiler p;
+    return p;
+  }
+
+  static const char* className(ItemClass c) noexcept;
+
+  bool enabled() const noexcept { return m_enabled; }
+  void setEnabled(bool b);
+
+  void beginFrame();
+  void endFrame(int visibleItems, int totalItems);
+  void addPaint(ItemClass c, std::chrono::nanoseconds t) noexcept
+  {
+    m_current.paintTime[c] += t.count();
+    m_current.paintCount[c]++;
+  }
+
+  const std::deque<Frame>& frames() const noexcept { return m_frames; }
+
+  //! Text shown in the overlay of the canvas.
+  QString summary() const;
+
+  //! Writes all the recorded frames in a JSON file.
+  bool saveTrace(const QString& path) const;
+
+private:
+  using clock = std::chrono::steady_clock;
+  RenderProfiler() = default;
+
+  Frame m_current;
+  std::deque<Frame> m_frames;
+  clock::time_point m_enableTime;
+  clock::time_point m_frameStart;
+  bool m_enabled{};
+};
+} // namespace SEGMent
@@ -5,6 +5,14 @@
 
 #include <score/model/path/Path.hpp>
 
+#include <QDataStream>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <limits>
+#include <vector>
+
 namespace SEGMent
 {
 
@@ -47,20 +55,117 @@ QString stringListToSemicolonString(const QJsonArray& array) {
 /**
  * These functions convert back and forth between
  * a score Path (e.g. a list of objects starting from the root of a document)
- * to a string that can be saved to json.
+ * to a string that can be saved to json, e.g.
+ *
+ * /SEGMentProcess.1/Scene.3/Image.2
+ *
+ * They run for every transition endpoint on save, load and paste:
+ * the string is written in a single allocation, and the object names are
+ * interned when parsing, so that all the paths share the same few names.
  */
 
+namespace detail
+{
+//! Returns a shared copy of an object name.
+inline QString internObjectName(const QStringRef& name)
+{
+  thread_local std::vector<QString> names;
+  for (const auto& n : names)
+  {
+    if (n == name)
+      return n;
+  }
+  names.push_back(name.toString());
+  return names.back();
+}
+
+//! Writes the decimal representation of a number, returns its end.
+inline QChar* writeNumber(QChar* out, int32_t num) noexcept
+{
+  char buf[16];
+  auto res = std::to_chars(buf, buf + sizeof(buf), num);
+  for (const char* c = buf; c != res.ptr; ++c)
+    *out++ = QLatin1Char(*c);
+  return out;
+}
+
+inline int numberSize(int32_t num) noexcept
+{
+  char buf[16];
+  return std::to_chars(buf, buf + sizeof(buf), num).ptr - buf;
+}
+
+//! Same as QString::toInt, e.g. 0 on invalid input.
+inline int32_t readNumber(const QChar* begin, const QChar* end) noexcept
+{
+  // Fast path for the ids written by pathToString: an optional '-' then
+  // digits. Anything else, e.g. a '+' or spaces, is left to Qt.
+  const QChar* const start = begin;
+  bool neg = false;
+  if (begin != end && *begin == QLatin1Char('-'))
+  {
+    neg = true;
+    ++begin;
+  }
+
+  int64_t num = 0;
+  bool plain = begin != end && end - begin <= 10;
+  for (const QChar* c = begin; plain && c != end; ++c)
+  {
+    const auto u = c->unicode();
+    if (u < '0' || u > '9')
+      plain = false;
+    else
+      num = num * 10 + (u - '0');
+  }
+
+  if (!plain)
+    return QString::fromRawData(start, int(end - start)).toInt();
+
+  num = neg ? -num : num;
+  if (num < std::numeric_limits<int32_t>::min()
+      || num > std::numeric_limits<int32_t>::max())
+    return 0;
+  return int32_t(num);
+}
+
+//! Object names in the paths of a SEGMent document, written as their
+//! index in the compact form. Only append to this list.
+inline const std::array<QString, 9>& knownObjectNames()
+{
+  static const std::array<QString, 9> names{
+      {QStringLiteral("SEGMentDocument"),
+       QStringLiteral("SEGMentProcess"),
+       QStringLiteral("Scene"),
+       QStringLiteral("SimpleObject"),
+       QStringLiteral("GifObject"),
+       QStringLiteral("ClickArea"),
+       QStringLiteral("BackClickArea"),
+       QStringLiteral("TextArea"),
+       QStringLiteral("Transition")}};
+  return names;
+}
+}
+
 template <typename T>
 QString pathToString(const Path<T>& p)
 {
-  QString s;
   const ObjectPath& path = p.unsafePath();
+
+  int size = 0;
+  for (auto& obj : path.vec())
+    size += 2 + obj.objectName().size() + detail::numberSize(obj.id());
+
+  QString s;
+  s.resize(size);
+  QChar* out = s.data();
   for (auto& obj : path.vec())
   {
-    s.append("/");
-    s.append(obj.objectName());
-    s.append(".");
-    s.append(QString::number(obj.id()));
+    const auto& name = obj.objectName();
+    *out++ = QLatin1Char('/');
+    out = std::copy(name.begin(), name.end(), out);
+    *out++ = QLatin1Char('.');
+    out = detail::writeNumber(out, obj.id());
   }
   return s;
 }
@@ -69,15 +174,115 @@ template <typename T>
 Path<T> pathFromString(const QString& s)
 {
   ObjectPath p;
-  const auto l = s.splitRef("/", QString::SplitBehavior::SkipEmptyParts);
-  for (auto& frag : l)
+  auto& vec = p.vec();
+  vec.reserve(s.count(QLatin1Char('/')));
+
+  const QChar* const data = s.constData();
+  const int n = s.size();
+  int begin = 0;
+  while (begin < n)
   {
-    auto dot = frag.lastIndexOf(".");
-    QString name = frag.mid(0, dot).toString();
-    int number = frag.mid(dot + 1).toInt();
-    p.vec().push_back(ObjectIdentifier{name, number});
+    int end = begin;
+    int dot = -1;
+    for (; end < n && data[end] != QLatin1Char('/'); ++end)
+    {
+      if (data[end] == QLatin1Char('.'))
+        dot = end;
+    }
+
+    if (end > begin)
+    {
+      if (dot == -1)
+      {
+        vec.push_back(ObjectIdentifier{
+            detail::internObjectName(s.midRef(begin, end - begin)),
+            detail::readNumber(data + begin, data + end)});
+      }
+      else
+      {
+        vec.push_back(ObjectIdentifier{
+            detail::internObjectName(s.midRef(begin, dot - begin)),
+            detail::readNumber(data + dot + 1, data + end)});
+      }
+    }
+    begin = end + 1;
   }
   return Path<T>{p, typename Path<T>::UnsafeDynamicCreation{}};
 }
 
+/**
+ * Compact form of a path in the DataStream format, e.g. for the transitions
+ * kept by the undo commands: a tag, the number of segments, then for each
+ * segment the index of its name in knownObjectNames, or -1 followed by the
+ * name, and the id. It is written and read straight from the stream.
+ *
+ * The tag tells it apart from the previous form, the one of ObjectPath,
+ * which starts with the number of segments.
+ */
+constexpr int32_t compactPathTag = -1;
+
+template <typename T>
+void writeCompactPath(QDataStream& s, const Path<T>& p)
+{
+  const auto& names = detail::knownObjectNames();
+  const auto& vec = p.unsafePath().vec();
+
+  s << compactPathTag << int32_t(vec.size());
+  for (auto& obj : vec)
+  {
+    const auto it = std::find(names.begin(), names.end(), obj.objectName());
+    if (it != names.end())
+    {
+      s << qint8(it - names.begin());
+    }
+    else
+    {
+      s << qint8(-1) << obj.objectName();
+    }
+    s << int32_t(obj.id());
+  }
+}
+
+template <typename T>
+void readCompactPath(QDataStream& s, Path<T>& p)
+{
+  const auto& names = detail::knownObjectNames();
+
+  int32_t tag{};
+  s >> tag;
+  const bool compact = tag == compactPathTag;
+
+  int32_t n = tag;
+  if (compact)
+    s >> n;
+
+  ObjectPath path;
+  auto& vec = path.vec();
+  if (n > 0)
+    vec.reserve(n);
+  for (int32_t i = 0; i < n && s.status() == QDataStream::Ok; i++)
+  {
+    QString name;
+    qint8 index = -1;
+    if (compact)
+      s >> index;
+
+    if (index >= 0 && std::size_t(index) < names.size())
+      name = names[index];
+    else if (index == -1)
+    {
+      s >> name;
+      name = detail::internObjectName(QStringRef{&name});
+    }
+    else
+      s.setStatus(QDataStream::ReadCorruptData);
+
+    int32_t id{};
+    s >> id;
+    vec.push_back(ObjectIdentifier{std::move(name), id});
+  }
+
+  p = Path<T>{path, typename Path<T>::UnsafeDynamicCreation{}};
+}
+
 }
@@ -62,15 +62,15 @@ auto dispatchItem(const QGraphicsItem* obj, F&& fun)
 template <typename F>
 auto dispatchSceneChildren(const SceneModel& scene, F&& fun)
 {
-  for(auto& o : scene.objects)
+  for(auto& o : scene.objects())
     fun(o);
-  for(auto& o : scene.gifs)
+  for(auto& o : scene.gifs())
     fun(o);
-  for(auto& o : scene.textAreas)
+  for(auto& o : scene.textAreas())
     fun(o);
-  for(auto& o : scene.clickAreas)
+  for(auto& o : scene.clickAreas())
     fun(o);
-  for(auto& o : scene.backClickAreas)
+  for(auto& o : scene.backClickAreas())
     fun(o);
 }
 
@@ -78,11 +78,11 @@ template <typename Scene_T, typename F>
 auto forEachCategoryInScene(Scene_T& v, F&& func)
 {
   const auto& objects = std::tie(
-              v.objects,
-              v.gifs,
-              v.clickAreas,
-              v.backClickAreas,
-              v.textAreas
+              v.objects(),
+              v.gifs(),
+              v.clickAreas(),
+              v.backClickAreas(),
+              v.textAreas()
   );
 
   ossia::for_each_in_tuple(objects, std::forward<F>(func));
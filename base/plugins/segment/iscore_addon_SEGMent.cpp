@@ -13,6 +13,7 @@
 #include <SEGMent/Model/Layer/ProcessPresenter.hpp>
 #include <SEGMent/Model/Layer/ProcessView.hpp>
 #include <SEGMent/Panel/Library.hpp>
+#include <SEGMent/Panel/Minimap.hpp>
 #include <SEGMent/ImageCache.hpp>
 #include <QTranslator>
 #include <iscore_addon_SEGMent_commands_files.hpp>
@@ -56,7 +57,9 @@ iscore_addon_SEGMent::factories(
          SEGMent::TextInspectorFactory,
          SEGMent::ClickInspectorFactory,
          SEGMent::BackClickInspectorFactory>,
-      FW<score::PanelDelegateFactory, SEGMent::LibraryFactory>>(ctx, key);
+      FW<score::PanelDelegateFactory,
+         SEGMent::LibraryFactory,
+         SEGMent::MinimapFactory>>(ctx, key);
 }
 
 std::pair<const CommandGroupKey, CommandGeneratorMap>
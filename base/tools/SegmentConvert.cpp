@@ -0,0 +1,183 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include <score/serialization/BinaryDocument.hpp>
+
+#include <QBuffer>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QTextStream>
+
+#include <stdexcept>
+
+/**
+ * Converts a save file between the JSON format, which is the one read by
+ * the game engine, and the sectioned binary format.
+ *
+ * The direction is given by the input file: binary documents are
+ * converted to JSON, and JSON documents to binary.
+ */
+namespace
+{
+QJsonObject readJson(const QString& path)
+{
+  QFile f{path};
+  if (!f.open(QIODevice::ReadOnly))
+    throw std::runtime_error(
+        path.toStdString() + ": " + f.errorString().toStdString());
+
+  QJsonParseError err;
+  auto json = QJsonDocument::fromJson(f.readAll(), &err);
+  if (err.error != QJsonParseError::NoError)
+    throw std::runtime_error(
+        path.toStdString() + ": " + err.errorString().toStdString());
+  if (!json.isObject())
+    throw std::runtime_error(path.toStdString() + ": not a project");
+
+  return json.object();
+}
+
+void write(const QString& path, const QByteArray& data)
+{
+  QSaveFile f{path};
+  if (!f.open(QIODevice::WriteOnly) || f.write(data) != data.size()
+      || !f.commit())
+    throw std::runtime_error("Cannot write " + path.toStdString());
+}
+
+QJsonObject toJson(const BinaryDocumentReader& reader)
+{
+  auto json = reader.toJson();
+  if (reader.hasError())
+    throw std::runtime_error(reader.errorString().toStdString());
+  return json;
+}
+
+//! Returns the JSON document which was converted, for verification.
+QJsonObject binaryToJson(
+    const QString& input,
+    const QString& output,
+    QJsonDocument::JsonFormat format)
+{
+  BinaryDocumentReader reader;
+  if (!reader.open(input))
+    throw std::runtime_error(
+        input.toStdString() + ": " + reader.errorString().toStdString());
+
+  auto json = toJson(reader);
+  write(output, QJsonDocument{json}.toJson(format));
+  return json;
+}
+
+QJsonObject jsonToBinary(
+    const QString& input,
+    const QString& output,
+    const QStringList& sections)
+{
+  auto json = readJson(input);
+
+  QBuffer buf;
+  buf.open(QIODevice::WriteOnly);
+  if (!BinaryDocumentWriter::fromJson(json, sections, buf))
+    throw std::runtime_error("Cannot convert " + input.toStdString());
+
+  write(output, buf.data());
+  return json;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName("segment-convert");
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(QCoreApplication::translate(
+      "main",
+      "Converts a SEGMent project between the JSON and binary formats."));
+  parser.addHelpOption();
+  parser.addPositionalArgument(
+      "input", QCoreApplication::translate("main", "Project to convert"));
+  parser.addPositionalArgument(
+      "output", QCoreApplication::translate("main", "Converted project"));
+
+  QCommandLineOption sectionOpt(
+      "section",
+      QCoreApplication::translate(
+          "main",
+          "Array stored as a section of the binary document, "
+          "e.g. Document/Process/Scenes. Can be repeated."),
+      "path");
+  QCommandLineOption compactOpt(
+      "compact",
+      QCoreApplication::translate("main", "Write compact JSON"));
+  QCommandLineOption verifyOpt(
+      "verify",
+      QCoreApplication::translate(
+          "main", "Read the output back and check that nothing was lost"));
+  parser.addOption(sectionOpt);
+  parser.addOption(compactOpt);
+  parser.addOption(verifyOpt);
+  parser.process(app);
+
+  const auto args = parser.positionalArguments();
+  if (args.size() != 2)
+    parser.showHelp(1);
+
+  const auto& input = args[0];
+  const auto& output = args[1];
+
+  try
+  {
+    QFile f{input};
+    if (!f.open(QIODevice::ReadOnly))
+      throw std::runtime_error(
+          input.toStdString() + ": " + f.errorString().toStdString());
+    const bool binary = BinaryDocumentReader::isBinaryDocument(f.peek(8));
+    f.close();
+
+    QJsonObject converted;
+    bool same = true;
+    if (binary)
+    {
+      converted = binaryToJson(
+          input,
+          output,
+          parser.isSet(compactOpt) ? QJsonDocument::Compact
+                                   : QJsonDocument::Indented);
+      if (parser.isSet(verifyOpt))
+        same = readJson(output) == converted;
+    }
+    else
+    {
+      QStringList sections = parser.values(sectionOpt);
+      if (sections.isEmpty())
+        sections = QStringList{"Document/Process/Scenes",
+                               "Document/Process/Transitions"};
+
+      converted = jsonToBinary(input, output, sections);
+      if (parser.isSet(verifyOpt))
+      {
+        BinaryDocumentReader reader;
+        if (!reader.open(output))
+          throw std::runtime_error(
+              output.toStdString() + ": "
+              + reader.errorString().toStdString());
+        same = toJson(reader) == converted;
+      }
+    }
+
+    if (!same)
+      throw std::runtime_error(
+          output.toStdString() + " differs from " + input.toStdString());
+  }
+  catch (const std::exception& e)
+  {
+    QTextStream{stderr} << e.what() << "\n";
+    return 1;
+  }
+
+  return 0;
+}